@@ -0,0 +1,505 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+#include <system_error>
+#include <new>
+#include <cerrno>
+#include <ctime>
+#include <cstring>
+#include <cstdint>
+#include <assert.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <poll.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/signalfd.h>
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+/*
+    Evaluation backend running an evaluation function in a pool of forked worker processes, so a crashing or leaking fitness function
+    does not bring down the population. Genes of gene_length chromosomes of type E and their fitness values of type L are passed as raw
+    records through a ring of slots in POSIX shared memory, each slot holding a batch of up to batch_size genes, without serialization:
+    the parent copies every gene into its record and every fitness value out of the slot, the worker copies the records into the gene
+    vectors the evaluation function takes and its fitness values into the slot. Workers which die (or whose evaluation function throws or
+    returns the wrong number of fitness values) while evaluating a batch are restarted and their batch is queued again; a batch that killed
+    max_attempts workers gets failure_fitness. A worker still evaluating a batch after timeout seconds is killed the same way, and a worker
+    exits after recycle_batches batches and is replaced, so memory leaked by the evaluation function is returned (0 disables both).
+    The workers are not forked by the parent, which may run other threads holding locks a forked copy would wait for forever, but by a
+    single-threaded spawner process forked once by the constructor, so the evaluator should be constructed before starting other threads.
+    operator() may be called from several threads (e.g. by populations of an Experiment sharing one evaluator), but the slots, the ring
+    position and the workers belong to one evaluation at a time, so concurrent calls are serialized and evaluated one after the other.
+*/
+template<typename E, typename L>
+class ProcessEvaluator{
+
+    static_assert(std::is_trivially_copyable_v<E> && std::is_trivially_copyable_v<L>, "chromosomes and fitness values passed to worker processes must be trivially copyable");
+
+private:
+
+    // slot states besides the pid of the worker which claimed the slot
+    static constexpr int slot_free = -1;
+    static constexpr int slot_ready = -2;
+    static constexpr int slot_done = -3;
+
+    // requests of the parent to the spawner
+    static constexpr int request_spawn = 0;
+    static constexpr int request_kill = 1;
+
+    struct Header{
+        sem_t tasks;
+        sem_t done;
+    };
+
+    struct Slot{
+        std::atomic<int> state;
+        int count;
+    };
+
+    struct Request{
+        int kind;
+        pid_t pid;
+    };
+
+    struct Exit{
+        pid_t pid;
+        int status;
+    };
+
+    std::function<std::vector<L>(const std::vector<std::vector<E>>&)> evaluate;
+    int gene_length;
+    int batch_size;
+    int slots_n;
+    int max_attempts;
+    L failure_fitness;
+    double timeout;
+    int recycle_batches;
+    size_t header_bytes;
+    size_t genes_offset;
+    size_t fitnesses_offset;
+    size_t slot_bytes;
+    size_t bytes;
+    char* memory;
+    int head;
+    int restarts;
+    pid_t spawner;
+    int control;    // socket for requests to the spawner and the pids of spawned workers
+    int exits;      // socket the spawner reports exited workers on
+    std::vector<pid_t> workers;
+    std::vector<pid_t> claimed_by;
+    std::vector<std::chrono::steady_clock::time_point> claimed_since;
+    std::mutex mutex;
+
+    Header* header();
+    Slot* slot(int index);
+    E* slot_genes(int index);
+    L* slot_fitnesses(int index);
+    pid_t spawn_worker();
+    [[noreturn]] void run_spawner(pid_t parent);
+    [[noreturn]] void run_worker();
+    void wait_done();
+    void kill_overdue();
+    void recover_workers(std::vector<int>& batch_of_slot, std::vector<int>& attempts, std::vector<L>& fitnesses, int genes_n, int& completed);
+
+public:
+
+    ProcessEvaluator(
+        const std::function<std::vector<L>(const std::vector<std::vector<E>>&)>& evaluate,
+        int gene_length,
+        int workers_n,
+        int batch_size,
+        L failure_fitness,
+        int max_attempts = 3,
+        double timeout = 0,
+        int recycle_batches = 0
+    );
+    ProcessEvaluator(const ProcessEvaluator&) = delete;
+    ProcessEvaluator& operator=(const ProcessEvaluator&) = delete;
+    ~ProcessEvaluator();
+
+    std::vector<L> operator()(const std::vector<std::vector<E>>& genes); //evaluates genes in the worker processes, concurrent calls wait for each other
+    int get_restarts(); //returns the number of workers restarted after they died or were killed
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+template<typename E, typename L>
+ProcessEvaluator<E, L>::ProcessEvaluator(
+    const std::function<std::vector<L>(const std::vector<std::vector<E>>&)>& evaluate,
+    int gene_length,
+    int workers_n,
+    int batch_size,
+    L failure_fitness,
+    int max_attempts,
+    double timeout,
+    int recycle_batches
+) : evaluate(evaluate), gene_length(gene_length), batch_size(batch_size), slots_n(2 * workers_n), max_attempts(max_attempts), failure_fitness(failure_fitness),
+    timeout(timeout), recycle_batches(recycle_batches), head(0), restarts(0), claimed_by(2 * workers_n, 0), claimed_since(2 * workers_n) {
+    assert((evaluate != nullptr && gene_length > 0 && workers_n > 0 && batch_size > 0 && timeout >= 0 && recycle_batches >= 0));
+    const size_t align = 64;
+    genes_offset = (sizeof(Slot) + alignof(E) - 1) / alignof(E) * alignof(E);
+    fitnesses_offset = (genes_offset + (size_t) batch_size * gene_length * sizeof(E) + alignof(L) - 1) / alignof(L) * alignof(L);
+    slot_bytes = (fitnesses_offset + batch_size * sizeof(L) + align - 1) / align * align;
+    header_bytes = (sizeof(Header) + align - 1) / align * align;
+    bytes = header_bytes + slots_n * slot_bytes;
+
+    std::string name = "/eaframework_" + std::to_string(getpid()) + "_" + std::to_string(reinterpret_cast<uintptr_t>(this));
+    int file = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(file < 0){
+        throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+    }
+    shm_unlink(name.c_str());
+    if(ftruncate(file, bytes) != 0){
+        int error = errno;
+        close(file);
+        throw std::system_error(error, std::generic_category(), "ftruncate " + name);
+    }
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+    if(mapping == MAP_FAILED){
+        throw std::system_error(errno, std::generic_category(), "mmap " + name);
+    }
+    memory = static_cast<char*>(mapping);
+
+    Header* h = new (memory) Header;
+    sem_init(&h->tasks, 1, 0);
+    sem_init(&h->done, 1, 0);
+    for(int i = 0; i < slots_n; i++){
+        Slot* s = new (memory + header_bytes + i * slot_bytes) Slot;
+        s->state.store(slot_free);
+        s->count = 0;
+    }
+
+    // datagram sockets keep requests and reports apart and fail with an error instead of SIGPIPE if the other side is gone
+    int control_sockets[2];
+    int exits_sockets[2];
+    if(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, control_sockets) != 0 || socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, exits_sockets) != 0){
+        throw std::system_error(errno, std::generic_category(), "socketpair");
+    }
+    const pid_t parent = getpid();
+    spawner = fork();
+    if(spawner < 0){
+        throw std::system_error(errno, std::generic_category(), "fork");
+    }
+    if(spawner == 0){
+        close(control_sockets[0]);
+        close(exits_sockets[0]);
+        control = control_sockets[1];
+        exits = exits_sockets[1];
+        run_spawner(parent);
+    }
+    close(control_sockets[1]);
+    close(exits_sockets[1]);
+    control = control_sockets[0];
+    exits = exits_sockets[0];
+    for(int i = 0; i < workers_n; i++){
+        workers.emplace_back(spawn_worker());
+    }
+}
+
+// The spawner kills the idle workers once the parent closes the control socket
+template<typename E, typename L>
+ProcessEvaluator<E, L>::~ProcessEvaluator(){
+    close(control);
+    waitpid(spawner, nullptr, 0);
+    close(exits);
+    sem_destroy(&header()->tasks);
+    sem_destroy(&header()->done);
+    munmap(memory, bytes);
+}
+
+template<typename E, typename L>
+typename ProcessEvaluator<E, L>::Header* ProcessEvaluator<E, L>::header(){
+    return reinterpret_cast<Header*>(memory);
+}
+
+template<typename E, typename L>
+typename ProcessEvaluator<E, L>::Slot* ProcessEvaluator<E, L>::slot(int index){
+    return reinterpret_cast<Slot*>(memory + header_bytes + index * slot_bytes);
+}
+
+template<typename E, typename L>
+E* ProcessEvaluator<E, L>::slot_genes(int index){
+    return reinterpret_cast<E*>(reinterpret_cast<char*>(slot(index)) + genes_offset);
+}
+
+template<typename E, typename L>
+L* ProcessEvaluator<E, L>::slot_fitnesses(int index){
+    return reinterpret_cast<L*>(reinterpret_cast<char*>(slot(index)) + fitnesses_offset);
+}
+
+template<typename E, typename L>
+pid_t ProcessEvaluator<E, L>::spawn_worker(){
+    Request request{request_spawn, 0};
+    pid_t pid;
+    if(send(control, &request, sizeof(request), MSG_NOSIGNAL) != sizeof(request) || recv(control, &pid, sizeof(pid), 0) != sizeof(pid)){
+        throw std::system_error(errno, std::generic_category(), "spawner");
+    }
+    if(pid < 0){
+        throw std::system_error(-pid, std::generic_category(), "fork");
+    }
+    return pid;
+}
+
+// Loop of the spawner process: forks workers and kills them on request of the parent and reports every exited worker, never returns
+template<typename E, typename L>
+void ProcessEvaluator<E, L>::run_spawner(pid_t parent){
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    if(getppid() != parent){
+        _exit(0);
+    }
+    sigset_t children;
+    sigemptyset(&children);
+    sigaddset(&children, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &children, nullptr);
+    int signals = signalfd(-1, &children, SFD_CLOEXEC);
+    std::vector<pid_t> alive;
+    pollfd events[2] = {{control, POLLIN, 0}, {signals, POLLIN, 0}};
+    while(true){
+        if(poll(events, 2, -1) < 0){
+            continue;
+        }
+        // exited workers are reaped before handling requests, so a pid to kill is still a worker and not reused by another process
+        if(events[1].revents & POLLIN){
+            signalfd_siginfo info;
+            read(signals, &info, sizeof(info));
+            Exit exit;
+            while((exit.pid = waitpid(-1, &exit.status, WNOHANG)) > 0){
+                alive.erase(std::remove(alive.begin(), alive.end(), exit.pid), alive.end());
+                send(exits, &exit, sizeof(exit), MSG_NOSIGNAL);
+            }
+        }
+        if(events[0].revents){
+            Request request;
+            if(recv(control, &request, sizeof(request), 0) != sizeof(request)){
+                break;
+            }
+            if(request.kind == request_spawn){
+                pid_t pid = fork();
+                if(pid == 0){
+                    close(signals);
+                    close(control);
+                    close(exits);
+                    sigprocmask(SIG_UNBLOCK, &children, nullptr);
+                    run_worker();
+                }
+                pid_t reply = pid < 0 ? -errno : pid;
+                if(pid > 0){
+                    alive.emplace_back(pid);
+                }
+                send(control, &reply, sizeof(reply), MSG_NOSIGNAL);
+            }else if(std::find(alive.begin(), alive.end(), request.pid) != alive.end()){
+                kill(request.pid, SIGKILL);
+            }
+        }
+    }
+    // the parent only destroys the evaluator between evaluations, so all workers are idle
+    for(pid_t worker : alive){
+        kill(worker, SIGKILL);
+    }
+    while(waitpid(-1, nullptr, 0) > 0){}
+    _exit(0);
+}
+
+// Loop of a worker process: claims ready slots by writing its pid into their state and evaluates them, never returns
+template<typename E, typename L>
+void ProcessEvaluator<E, L>::run_worker(){
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    const int pid = getpid();
+    int batches = 0;
+    std::vector<std::vector<E>> genes;
+    while(true){
+        if(sem_wait(&header()->tasks) != 0){
+            continue;
+        }
+        for(int i = 0; i < slots_n; i++){
+            int expected = slot_ready;
+            if(!slot(i)->state.compare_exchange_strong(expected, pid)){
+                continue;
+            }
+            // an exception must not unwind out of the worker into the code of the parent it was forked from, so it counts as a crash
+            try{
+                // the records are copied once into the genes of the evaluation function, whose buffers are reused between batches
+                genes.resize(slot(i)->count);
+                for(int j = 0; j < slot(i)->count; j++){
+                    const E* record = slot_genes(i) + (size_t) j * gene_length;
+                    genes[j].assign(record, record + gene_length);
+                }
+                std::vector<L> fitnesses = evaluate(genes);
+                if(fitnesses.size() != genes.size()){
+                    _exit(1);
+                }
+                std::copy(fitnesses.begin(), fitnesses.end(), slot_fitnesses(i));
+            }catch(...){
+                _exit(1);
+            }
+            slot(i)->state.store(slot_done);
+            sem_post(&header()->done);
+            if(recycle_batches > 0 && ++batches >= recycle_batches){
+                _exit(0);
+            }
+            break;
+        }
+    }
+}
+
+template<typename E, typename L>
+void ProcessEvaluator<E, L>::wait_done(){
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += 1000000;
+    if(deadline.tv_nsec >= 1000000000){
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000;
+    }
+    sem_timedwait(&header()->done, &deadline);
+}
+
+// Has the spawner kill workers evaluating their batch for more than timeout seconds, measured from when the parent first sees the claim
+template<typename E, typename L>
+void ProcessEvaluator<E, L>::kill_overdue(){
+    auto now = std::chrono::steady_clock::now();
+    for(int i = 0; i < slots_n; i++){
+        int state = slot(i)->state.load();
+        if(state <= 0){
+            continue;
+        }
+        if(claimed_by[i] != state){
+            claimed_by[i] = state;
+            claimed_since[i] = now;
+        }else if(std::chrono::duration<double>(now - claimed_since[i]).count() > timeout){
+            Request request{request_kill, state};
+            send(control, &request, sizeof(request), MSG_NOSIGNAL);
+            claimed_since[i] = std::chrono::steady_clock::time_point::max();
+        }
+    }
+}
+
+// Replaces exited workers and queues the batches they had claimed again, or fails them after max_attempts
+template<typename E, typename L>
+void ProcessEvaluator<E, L>::recover_workers(std::vector<int>& batch_of_slot, std::vector<int>& attempts, std::vector<L>& fitnesses, int genes_n, int& completed){
+    Exit exit;
+    while(recv(exits, &exit, sizeof(exit), MSG_DONTWAIT) == sizeof(exit)){
+        auto worker = std::find(workers.begin(), workers.end(), exit.pid);
+        if(worker == workers.end()){
+            continue;
+        }
+        // a recycled worker exits cleanly after finishing its batch
+        bool crashed = !WIFEXITED(exit.status) || WEXITSTATUS(exit.status) != 0;
+        for(int i = 0; i < slots_n; i++){
+            if(slot(i)->state.load() != exit.pid){
+                continue;
+            }
+            crashed = true;
+            claimed_by[i] = 0;
+            int batch = batch_of_slot[i];
+            if(++attempts[batch] >= max_attempts){
+                int begin = batch * batch_size;
+                std::fill(fitnesses.begin() + begin, fitnesses.begin() + std::min(genes_n, begin + batch_size), failure_fitness);
+                slot(i)->state.store(slot_free);
+                completed++;
+            }else{
+                slot(i)->state.store(slot_ready);
+                sem_post(&header()->tasks);
+            }
+        }
+        if(crashed){
+            // the worker may have died after taking a task from the semaphore but before claiming its slot
+            sem_post(&header()->tasks);
+            restarts++;
+        }
+        *worker = spawn_worker();
+    }
+}
+
+template<typename E, typename L>
+std::vector<L> ProcessEvaluator<E, L>::operator()(const std::vector<std::vector<E>>& genes){
+    std::lock_guard<std::mutex> lock(mutex);
+    const int genes_n = genes.size();
+    const int batches_n = (genes_n + batch_size - 1) / batch_size;
+    std::vector<L> fitnesses(genes_n);
+    std::vector<int> batch_of_slot(slots_n, -1);
+    std::vector<int> attempts(batches_n, 0);
+    int next_batch = 0;
+    int completed = 0;
+    while(completed < batches_n){
+        // the parent writes batches into free slots in ring order, starting after the last slot it wrote
+        for(int k = 0; k < slots_n && next_batch < batches_n; k++){
+            int i = (head + k) % slots_n;
+            if(slot(i)->state.load() != slot_free){
+                continue;
+            }
+            int begin = next_batch * batch_size;
+            int count = std::min(batch_size, genes_n - begin);
+            for(int j = 0; j < count; j++){
+                assert(genes[begin + j].size() == gene_length);
+                std::memcpy(slot_genes(i) + (size_t) j * gene_length, genes[begin + j].data(), gene_length * sizeof(E));
+            }
+            slot(i)->count = count;
+            batch_of_slot[i] = next_batch++;
+            claimed_by[i] = 0;
+            slot(i)->state.store(slot_ready);
+            sem_post(&header()->tasks);
+            head = (i + 1) % slots_n;
+        }
+        wait_done();
+        for(int i = 0; i < slots_n; i++){
+            if(slot(i)->state.load() != slot_done){
+                continue;
+            }
+            int begin = batch_of_slot[i] * batch_size;
+            std::copy(slot_fitnesses(i), slot_fitnesses(i) + slot(i)->count, fitnesses.begin() + begin);
+            slot(i)->state.store(slot_free);
+            completed++;
+        }
+        if(timeout > 0){
+            kill_overdue();
+        }
+        recover_workers(batch_of_slot, attempts, fitnesses, genes_n, completed);
+    }
+    return fitnesses;
+}
+
+template<typename E, typename L>
+int ProcessEvaluator<E, L>::get_restarts(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return restarts;
+}
+
+// Evaluation Operators -------------------------------------------------------------
+
+/*
+    Process Evaluation: Evaluates genes with the passed evaluation function in a pool of worker processes
+    Arguments:
+        - evaluate:         evaluation function run inside the workers
+        - gene_length:      number of chromosomes of every gene
+        - workers_n:        number of worker processes
+        - batch_size:       maximal number of genes passed to a worker at once
+        - failure_fitness:  fitness assigned to genes whose batch crashed max_attempts workers
+        - max_attempts:     number of workers a batch may crash before it fails
+        - timeout:          seconds after which a worker evaluating a batch is killed and the batch queued again, 0 for no limit
+        - recycle_batches:  number of batches after which a worker is replaced by a new one, 0 to keep workers until they crash
+*/
+
+template<typename E, typename L>
+std::function<std::vector<L>(const std::vector<std::vector<E>>&)> evaluate_processes(const std::function<std::vector<L>(const std::vector<std::vector<E>>&)>& evaluate, int gene_length, int workers_n, int batch_size, L failure_fitness, int max_attempts = 3, double timeout = 0, int recycle_batches = 0) {
+    std::shared_ptr<ProcessEvaluator<E, L>> evaluator = std::make_shared<ProcessEvaluator<E, L>>(evaluate, gene_length, workers_n, batch_size, failure_fitness, max_attempts, timeout, recycle_batches);
+    return [evaluator](const std::vector<std::vector<E>>& genes) -> std::vector<L> {
+        return (*evaluator)(genes);
+    };
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <mutex>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <assert.h>
+
+#include "thread_pool.hpp"
+#include "../population/population.hpp"
+
+// Summary of a single run of an experiment
+struct RunSummary{
+    int configuration;      // index of the configuration of the run
+    int seed;               // seed of the population
+    double best_fitness;    // best fitness value evaluated during the run
+    double time_to_target;  // seconds until a fitness value reaching the target was evaluated, -1 if it never was
+    long evaluations;       // number of evaluated genes
+    int generations;        // number of executed generations
+    double time;            // seconds the run took
+    bool eliminated;        // whether the run was stopped early because racing eliminated its configuration
+    bool skipped;           // whether the run was not executed because its configuration was eliminated before it started, its results are empty
+};
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+/*
+    Class for experiments executing one run per configuration of type C and seed on a shared thread pool. Every run builds its population of
+    genes of type T with single fitness values from its configuration, its seed and the shared evaluation function, so read-only problem
+    data captured by the evaluation function exists once for all runs.
+    With racing enabled, the runs report their best fitness after every stage of stage_generations generations, and configurations whose
+    mean best fitness is clearly below the one of the leading configuration (confidence intervals of z standard errors do not overlap,
+    with at least min_runs results per configuration) are eliminated; their runs stop and their remaining runs are skipped.
+*/
+template<typename T, typename C, typename G = std::mt19937>
+class Experiment{
+
+    using L = double;
+
+private:
+
+    std::vector<C> configurations;
+    std::vector<int> seeds;
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate;
+    std::function<Population<T, L, G>(const C&, int, const std::function<std::vector<L>(const std::vector<T>&)>&)> build;
+    int generations;
+    double target;
+    int stage_generations;
+    int min_runs;
+    double z;
+
+    std::mutex mutex;
+    std::vector<std::vector<std::vector<double>>> stage_bests; // best fitness values per configuration and stage
+    std::vector<bool> eliminated;
+
+    RunSummary run_single(int configuration, int seed);
+    bool record_stage(int configuration, int stage, double best); //returns whether the configuration is eliminated
+    bool is_eliminated(int configuration);
+
+public:
+
+    Experiment(
+        const std::vector<C>& configurations,
+        const std::vector<int>& seeds,
+        const std::function<std::vector<L>(const std::vector<T>&)>& evaluate,
+        const std::function<Population<T, L, G>(const C&, int, const std::function<std::vector<L>(const std::vector<T>&)>&)>& build,
+        int generations,
+        double target = std::numeric_limits<double>::infinity()
+    );
+
+    void set_racing(int stage_generations, int min_runs = 3, double z = 2.0); //enables racing, stage_generations = 0 disables it
+    std::vector<RunSummary> run(ThreadPool& pool, const std::function<void(const RunSummary&)>& report = nullptr); //executes all runs, reporting each summary when its run is finished (skipped runs are flagged)
+    std::vector<bool> get_eliminated(); //returns which configurations were eliminated by racing
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+template<typename T, typename C, typename G>
+Experiment<T, C, G>::Experiment(
+    const std::vector<C>& configurations,
+    const std::vector<int>& seeds,
+    const std::function<std::vector<L>(const std::vector<T>&)>& evaluate,
+    const std::function<Population<T, L, G>(const C&, int, const std::function<std::vector<L>(const std::vector<T>&)>&)>& build,
+    int generations,
+    double target
+) : configurations(configurations), seeds(seeds), evaluate(evaluate), build(build), generations(generations), target(target), stage_generations(0), min_runs(3), z(2.0) {
+    assert((evaluate != nullptr && build != nullptr));
+}
+
+template<typename T, typename C, typename G>
+void Experiment<T, C, G>::set_racing(int stage_generations, int min_runs, double z){
+    this->stage_generations = stage_generations;
+    this->min_runs = std::max(2, min_runs);
+    this->z = z;
+}
+
+template<typename T, typename C, typename G>
+std::vector<RunSummary> Experiment<T, C, G>::run(ThreadPool& pool, const std::function<void(const RunSummary&)>& report){
+    stage_bests.assign(configurations.size(), {});
+    eliminated.assign(configurations.size(), false);
+    std::vector<RunSummary> summaries;
+    // runs are submitted seed by seed, so every configuration has results early on for racing
+    for(int seed : seeds){
+        for(int configuration = 0; configuration < configurations.size(); configuration++){
+            pool.submit([this, configuration, seed, &summaries, &report]{
+                RunSummary summary = run_single(configuration, seed);
+                std::lock_guard<std::mutex> lock(mutex);
+                summaries.emplace_back(summary);
+                if(report != nullptr){
+                    report(summary);
+                }
+            });
+        }
+    }
+    pool.wait();
+    return summaries;
+}
+
+template<typename T, typename C, typename G>
+RunSummary Experiment<T, C, G>::run_single(int configuration, int seed){
+    RunSummary summary = {configuration, seed, -std::numeric_limits<double>::infinity(), -1, 0, 0, 0, false, false};
+    if(is_eliminated(configuration)){
+        summary.eliminated = true;
+        summary.skipped = true;
+        return summary;
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_tracked = [this, &summary, start](const std::vector<T>& genes) -> std::vector<L> {
+        std::vector<L> fitnesses = evaluate(genes);
+        summary.evaluations += genes.size();
+        if(!fitnesses.empty()){
+            summary.best_fitness = std::max(summary.best_fitness, *std::max_element(fitnesses.begin(), fitnesses.end()));
+        }
+        if(summary.time_to_target < 0 && summary.best_fitness >= target){
+            summary.time_to_target = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        return fitnesses;
+    };
+    Population<T, L, G> population = build(configurations[configuration], seed, evaluate_tracked);
+    for(int generation = 1; generation <= generations; generation++){
+        population.execute();
+        summary.generations++;
+        if(stage_generations > 0 && generation % stage_generations == 0 && record_stage(configuration, generation / stage_generations - 1, summary.best_fitness)){
+            summary.eliminated = true;
+            break;
+        }
+    }
+    summary.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
+
+template<typename T, typename C, typename G>
+bool Experiment<T, C, G>::record_stage(int configuration, int stage, double best){
+    std::lock_guard<std::mutex> lock(mutex);
+    if(stage_bests[configuration].size() <= stage){
+        stage_bests[configuration].resize(stage + 1);
+    }
+    stage_bests[configuration][stage].emplace_back(best);
+    // confidence interval of the mean best fitness of every configuration with enough results at this stage
+    std::vector<std::pair<double, double>> intervals(configurations.size(), {0, 0});
+    std::vector<bool> complete(configurations.size(), false);
+    double leader_lower = -std::numeric_limits<double>::infinity();
+    for(int c = 0; c < configurations.size(); c++){
+        if(eliminated[c] || stage_bests[c].size() <= stage || stage_bests[c][stage].size() < min_runs){
+            continue;
+        }
+        const std::vector<double>& bests = stage_bests[c][stage];
+        double mean = std::accumulate(bests.begin(), bests.end(), 0.0) / bests.size();
+        double variance = 0;
+        for(double value : bests){
+            variance += (value - mean) * (value - mean);
+        }
+        double error = std::sqrt(variance / (bests.size() - 1) / bests.size());
+        intervals[c] = {mean - z * error, mean + z * error};
+        complete[c] = true;
+        leader_lower = std::max(leader_lower, intervals[c].first);
+    }
+    for(int c = 0; c < configurations.size(); c++){
+        if(complete[c] && intervals[c].second < leader_lower){
+            eliminated[c] = true;
+        }
+    }
+    return eliminated[configuration];
+}
+
+template<typename T, typename C, typename G>
+bool Experiment<T, C, G>::is_eliminated(int configuration){
+    std::lock_guard<std::mutex> lock(mutex);
+    return eliminated[configuration];
+}
+
+template<typename T, typename C, typename G>
+std::vector<bool> Experiment<T, C, G>::get_eliminated(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return eliminated;
+}
+
+// Configurations -------------------------------------------------------------------------------------------------------------------------
+
+template<size_t I, typename... P>
+void extend_configuration_grid(std::vector<std::tuple<P...>>& grid, const std::vector<std::tuple_element_t<I, std::tuple<P...>>>& values){
+    std::vector<std::tuple<P...>> extended;
+    extended.reserve(grid.size() * values.size());
+    for(const std::tuple<P...>& configuration : grid){
+        for(const auto& value : values){
+            extended.emplace_back(configuration);
+            std::get<I>(extended.back()) = value;
+        }
+    }
+    grid = std::move(extended);
+}
+
+template<typename... P, size_t... I>
+std::vector<std::tuple<P...>> configuration_grid_indexed(std::index_sequence<I...>, const std::vector<P>&... values){
+    std::vector<std::tuple<P...>> grid(1);
+    (extend_configuration_grid<I, P...>(grid, values), ...);
+    return grid;
+}
+
+/*
+    Configuration Grid: Returns every combination of the passed parameter values as a tuple, e.g. configuration_grid<int, double>({2, 4}, {0.1, 0.5})
+*/
+template<typename... P>
+std::vector<std::tuple<P...>> configuration_grid(const std::vector<P>&... values){
+    return configuration_grid_indexed<P...>(std::index_sequence_for<P...>(), values...);
+}
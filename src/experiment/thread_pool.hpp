@@ -0,0 +1,152 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <utility>
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+// Work-stealing thread pool: every worker has its own queue, works on it in submission order and steals from the back of the other queues when idle
+class ThreadPool{
+
+private:
+
+    struct Queue{
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::atomic<int> pending;
+    std::atomic<int> queued;
+    std::atomic<int> next_queue;
+    bool stop;
+
+    static std::pair<ThreadPool*, int>& worker(); //pool and queue index of the calling worker thread
+    int worker_index(); //queue index of the calling thread if it is a worker of this pool, -1 otherwise
+    bool take(int index, std::function<void()>& task);
+    void work(int index);
+
+public:
+
+    explicit ThreadPool(int threads_n = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    void submit(std::function<void()> task); //queues a task, on the own queue when called from a worker
+    void wait(); //blocks until all submitted tasks are finished
+    int size(); //returns the number of worker threads
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+inline ThreadPool::ThreadPool(int threads_n) : pending(0), queued(0), next_queue(0), stop(false) {
+    threads_n = std::max(1, threads_n);
+    for(int i = 0; i < threads_n; i++){
+        queues.emplace_back(std::make_unique<Queue>());
+    }
+    for(int i = 0; i < threads_n; i++){
+        threads.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+inline ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_all();
+    for(std::thread& thread : threads){
+        thread.join();
+    }
+}
+
+inline std::pair<ThreadPool*, int>& ThreadPool::worker(){
+    thread_local std::pair<ThreadPool*, int> current(nullptr, -1);
+    return current;
+}
+
+inline int ThreadPool::worker_index(){
+    return worker().first == this ? worker().second : -1;
+}
+
+inline void ThreadPool::submit(std::function<void()> task){
+    int index = worker_index();
+    if(index < 0){
+        index = next_queue++ % (int) queues.size();
+    }
+    pending++;
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.emplace_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued++;
+    }
+    wake.notify_one();
+}
+
+inline bool ThreadPool::take(int index, std::function<void()>& task){
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        if(!queues[index]->tasks.empty()){
+            task = std::move(queues[index]->tasks.front());
+            queues[index]->tasks.pop_front();
+            return true;
+        }
+    }
+    for(int k = 1; k < (int) queues.size(); k++){
+        Queue& victim = *queues[(index + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.tasks.empty()){
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void ThreadPool::work(int index){
+    worker() = std::make_pair(this, index);
+    while(true){
+        std::function<void()> task;
+        if(take(index, task)){
+            queued--;
+            task();
+            if(--pending == 0){
+                std::lock_guard<std::mutex> lock(mutex);
+                idle.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [this]{ return stop || queued > 0; });
+        if(stop && queued == 0){
+            return;
+        }
+    }
+}
+
+inline void ThreadPool::wait(){
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]{ return pending == 0; });
+}
+
+inline int ThreadPool::size(){
+    return threads.size();
+}
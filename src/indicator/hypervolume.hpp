@@ -0,0 +1,314 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <assert.h>
+
+// Hypervolume ------------------------------------------------------------------------------------------------------------------------------
+
+/*
+    Hypervolume of points of a maximization problem: the volume dominated by the points and bounded below by the reference point.
+    Points which do not exceed the reference point in every objective do not contribute.
+    - 1 and 2 objectives: exact sweep in O(N log N)
+    - 3 and more objectives: WFG algorithm, the sum of the exclusive hypervolumes of the points, each computed as the volume of the point
+      minus the hypervolume of its limit set, recursively in the same number of objectives
+*/
+
+using HypervolumePoint = std::vector<double>;
+
+// Returns whether p1 dominates p2 (at least as good in every objective and better in one)
+inline bool hypervolume_dominates(const HypervolumePoint& p1, const HypervolumePoint& p2) {
+    bool better = false;
+    for (int i = 0; i < p1.size(); i++) {
+        if (p1[i] < p2[i]) {
+            return false;
+        }
+        better = better || p1[i] > p2[i];
+    }
+    return better;
+}
+
+// Returns the points exceeding the reference point in every objective
+inline std::vector<HypervolumePoint> hypervolume_filter(const std::vector<HypervolumePoint>& points, const HypervolumePoint& reference) {
+    std::vector<HypervolumePoint> filtered;
+    filtered.reserve(points.size());
+    for (const HypervolumePoint& point : points) {
+        bool above = true;
+        for (int i = 0; i < reference.size(); i++) {
+            above = above && point[i] > reference[i];
+        }
+        if (above) {
+            filtered.emplace_back(point);
+        }
+    }
+    return filtered;
+}
+
+// Removes dominated points and duplicates, the points have to be sorted by the first objective in descending order
+inline std::vector<HypervolumePoint> hypervolume_nondominated(const std::vector<HypervolumePoint>& sorted_points) {
+    std::vector<HypervolumePoint> front;
+    for (const HypervolumePoint& point : sorted_points) {
+        bool dominated = false;
+        for (const HypervolumePoint& member : front) {
+            if (member == point || hypervolume_dominates(member, point)) {
+                dominated = true;
+                break;
+            }
+        }
+        if (!dominated) {
+            front.emplace_back(point);
+        }
+    }
+    return front;
+}
+
+inline void hypervolume_sort(std::vector<HypervolumePoint>& points) {
+    std::sort(points.begin(), points.end(), [](const HypervolumePoint& a, const HypervolumePoint& b) {
+        return a > b;
+    });
+}
+
+// Sweep over the points sorted by the first objective in descending order, the second objective of the front is then ascending
+inline double hypervolume_2d(std::vector<HypervolumePoint> points, const HypervolumePoint& reference) {
+    hypervolume_sort(points);
+    double volume = 0;
+    double y_max = reference[1];
+    for (const HypervolumePoint& point : points) {
+        if (point[1] > y_max) {
+            volume += (point[0] - reference[0]) * (point[1] - y_max);
+            y_max = point[1];
+        }
+    }
+    return volume;
+}
+
+inline double hypervolume_wfg(const std::vector<HypervolumePoint>& front, const HypervolumePoint& reference);
+
+// Volume dominated by front[k] but by none of front[k+1..], computed from the limit set of front[k]
+inline double hypervolume_exclusive(const std::vector<HypervolumePoint>& front, int k, const HypervolumePoint& reference) {
+    double inclusive = 1;
+    for (int i = 0; i < reference.size(); i++) {
+        inclusive *= front[k][i] - reference[i];
+    }
+    std::vector<HypervolumePoint> limit_set;
+    limit_set.reserve(front.size() - k - 1);
+    for (int j = k + 1; j < front.size(); j++) {
+        HypervolumePoint limited(reference.size());
+        for (int i = 0; i < reference.size(); i++) {
+            limited[i] = std::min(front[k][i], front[j][i]);
+        }
+        limit_set.emplace_back(std::move(limited));
+    }
+    hypervolume_sort(limit_set);
+    return inclusive - hypervolume_wfg(hypervolume_nondominated(limit_set), reference);
+}
+
+// WFG on a nondominated front sorted by the first objective in descending order
+inline double hypervolume_wfg(const std::vector<HypervolumePoint>& front, const HypervolumePoint& reference) {
+    if (front.empty()) {
+        return 0;
+    }
+    if (reference.size() == 2) {
+        return hypervolume_2d(front, reference);
+    }
+    double volume = 0;
+    for (int k = 0; k < front.size(); k++) {
+        volume += hypervolume_exclusive(front, k, reference);
+    }
+    return volume;
+}
+
+/*
+    Hypervolume: Returns the hypervolume of points with respect to the reference point
+*/
+inline double hypervolume(const std::vector<HypervolumePoint>& points, const HypervolumePoint& reference) {
+    std::vector<HypervolumePoint> filtered = hypervolume_filter(points, reference);
+    if (filtered.empty()) {
+        return 0;
+    }
+    if (reference.size() == 1) {
+        double best = reference[0];
+        for (const HypervolumePoint& point : filtered) {
+            best = std::max(best, point[0]);
+        }
+        return best - reference[0];
+    }
+    if (reference.size() == 2) {
+        return hypervolume_2d(std::move(filtered), reference);
+    }
+    hypervolume_sort(filtered);
+    return hypervolume_wfg(hypervolume_nondominated(filtered), reference);
+}
+
+/*
+    Hypervolume Contributions: Returns for every point of the nondominated front of points the volume dominated by it and by no other point
+    of the front (0 for dominated points and duplicates)
+    - 2 objectives: O(N log N) from the neighbours on the sorted front
+    - 3 and more objectives: exclusive hypervolume of every front point with respect to the others
+*/
+inline std::vector<double> hypervolume_contributions(const std::vector<HypervolumePoint>& points, const HypervolumePoint& reference) {
+    std::vector<double> contributions(points.size(), 0);
+    std::vector<int> indices;
+    for (int i = 0; i < points.size(); i++) {
+        bool above = true;
+        for (int j = 0; j < reference.size(); j++) {
+            above = above && points[i][j] > reference[j];
+        }
+        if (above) {
+            indices.emplace_back(i);
+        }
+    }
+    if (reference.size() == 2) {
+        std::sort(indices.begin(), indices.end(), [&](int a, int b) {
+            return points[a] > points[b];
+        });
+        // indices of the front, ascending in the second objective, and whether a front point occurs more than once
+        std::vector<int> front;
+        std::vector<bool> duplicated;
+        for (int index : indices) {
+            if (front.empty() || points[index][1] > points[front.back()][1]) {
+                front.emplace_back(index);
+                duplicated.emplace_back(false);
+            } else if (points[index] == points[front.back()]) {
+                duplicated.back() = true;
+            }
+        }
+        for (int k = 0; k < front.size(); k++) {
+            double x_next = k + 1 < front.size() ? points[front[k + 1]][0] : reference[0];
+            double y_previous = k > 0 ? points[front[k - 1]][1] : reference[1];
+            contributions[front[k]] = duplicated[k] ? 0 : (points[front[k]][0] - x_next) * (points[front[k]][1] - y_previous);
+        }
+        return contributions;
+    }
+    std::vector<int> front;
+    for (int i : indices) {
+        bool dominated = false;
+        for (int j : indices) {
+            if ((j < i && points[j] == points[i]) || hypervolume_dominates(points[j], points[i])) {
+                dominated = true;
+                break;
+            }
+        }
+        if (!dominated) {
+            front.emplace_back(i);
+        }
+    }
+    for (int i : front) {
+        // point i is moved to the front of the list, so its exclusive volume is computed against all other front points
+        std::vector<HypervolumePoint> others = {points[i]};
+        bool duplicated = false;
+        for (int j : indices) {
+            duplicated = duplicated || (j != i && points[j] == points[i]);
+        }
+        for (int j : front) {
+            if (j != i) {
+                others.emplace_back(points[j]);
+            }
+        }
+        if (!duplicated) {
+            contributions[i] = hypervolume_exclusive(others, 0, reference);
+        }
+    }
+    return contributions;
+}
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+// Archive of nondominated points whose hypervolume is updated incrementally by the exclusive contribution of every inserted point
+class HypervolumeArchive{
+
+private:
+
+    HypervolumePoint reference;
+    std::vector<HypervolumePoint> front;
+    double volume;
+
+public:
+
+    explicit HypervolumeArchive(const HypervolumePoint& reference);
+
+    double insert(const HypervolumePoint& point); //inserts a point and returns its contribution to the hypervolume (0 if it is dominated)
+    double get_hypervolume(); //returns the hypervolume of the archive
+    const std::vector<HypervolumePoint>& get_points(); //returns the nondominated points of the archive
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+inline HypervolumeArchive::HypervolumeArchive(const HypervolumePoint& reference) : reference(reference), volume(0) {}
+
+inline double HypervolumeArchive::insert(const HypervolumePoint& point){
+    for(int i = 0; i < reference.size(); i++){
+        if(point[i] <= reference[i]){
+            return 0;
+        }
+    }
+    for(const HypervolumePoint& member : front){
+        if(member == point || hypervolume_dominates(member, point)){
+            return 0;
+        }
+    }
+    std::vector<HypervolumePoint> others = {point};
+    others.insert(others.end(), front.begin(), front.end());
+    double contribution = hypervolume_exclusive(others, 0, reference);
+    volume += contribution;
+    front.erase(std::remove_if(front.begin(), front.end(), [&point](const HypervolumePoint& member) {
+        return hypervolume_dominates(point, member);
+    }), front.end());
+    front.emplace_back(point);
+    return contribution;
+}
+
+inline double HypervolumeArchive::get_hypervolume(){
+    return volume;
+}
+
+inline const std::vector<HypervolumePoint>& HypervolumeArchive::get_points(){
+    return front;
+}
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+/*
+    Stagnation criterion: tracks the hypervolume of the fitness values of every generation and reports stagnation once it did not grow by
+    more than tolerance within the last window generations
+*/
+class HypervolumeStagnation{
+
+private:
+
+    HypervolumePoint reference;
+    int window;
+    double tolerance;
+    std::vector<double> history;
+
+public:
+
+    HypervolumeStagnation(const HypervolumePoint& reference, int window, double tolerance = 0);
+
+    bool update(const std::vector<HypervolumePoint>& fitnesses); //records the hypervolume of one generation and returns whether the run stagnates
+    double get_hypervolume(); //returns the last recorded hypervolume
+    const std::vector<double>& get_history(); //returns the recorded hypervolume of every generation
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+inline HypervolumeStagnation::HypervolumeStagnation(const HypervolumePoint& reference, int window, double tolerance) : reference(reference), window(window), tolerance(tolerance) {
+    assert(window > 0);
+}
+
+inline bool HypervolumeStagnation::update(const std::vector<HypervolumePoint>& fitnesses){
+    history.emplace_back(hypervolume(fitnesses, reference));
+    return history.size() > window && history.back() - history[history.size() - 1 - window] <= tolerance;
+}
+
+inline double HypervolumeStagnation::get_hypervolume(){
+    return history.empty() ? 0 : history.back();
+}
+
+inline const std::vector<double>& HypervolumeStagnation::get_history(){
+    return history;
+}
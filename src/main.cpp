@@ -1,7 +1,24 @@
 #include "tests/mix_tests.hpp"
+#include "tests/mapped_tests.hpp"
+#include "tests/process_tests.hpp"
+#include "tests/experiment_tests.hpp"
+#include "tests/portfolio_tests.hpp"
+#include "tests/hypervolume_tests.hpp"
+#include "tests/nsga_tests.hpp"
+#include "tests/real_tests.hpp"
+#include "tests/random_tests.hpp"
 
 int main() {
     test_bel3um();
     test_sum();
+    test_sum_streaming();
     test_scheduling();
+    test_mapped();
+    test_process();
+    test_experiment();
+    test_portfolio();
+    test_hypervolume();
+    test_nsga2();
+    test_real();
+    test_random();
 }
\ No newline at end of file
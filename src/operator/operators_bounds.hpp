@@ -0,0 +1,50 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+// Bounds Handling ------------------------------------------------------------------
+
+// How real-valued chromosomes leaving [lower, upper] are brought back
+enum class BoundsHandling{
+    clamp,      // set to the violated bound
+    reflect     // mirrored at the violated bound (and clamped if they are still outside)
+};
+
+// Brings the chromosomes of a gene back into [lower, upper], the loop has no branches, so it is vectorized
+template<typename F>
+void apply_bounds(std::vector<F>& gene, F lower, F upper, BoundsHandling handling) {
+    F* x = gene.data();
+    if (handling == BoundsHandling::reflect) {
+        for (size_t i = 0; i < gene.size(); i++) {
+            F value = x[i] > upper ? 2 * upper - x[i] : x[i];
+            value = value < lower ? 2 * lower - value : value;
+            x[i] = std::min(upper, std::max(lower, value));
+        }
+    } else {
+        for (size_t i = 0; i < gene.size(); i++) {
+            x[i] = std::min(upper, std::max(lower, x[i]));
+        }
+    }
+}
+
+/*
+    Bounds Repair: Brings all chromosomes of real-valued genes back into [lower, upper], can be passed as mutation after operators without bounds handling
+    Arguments:
+        - lower:    lower bound of every chromosome
+        - upper:    upper bound of every chromosome
+        - handling: clamp or reflect chromosomes leaving the bounds
+*/
+
+template<typename F, typename G = std::mt19937>
+std::function<std::vector<std::vector<F>>(const std::vector<std::vector<F>>&, G&)> repair_bounds(F lower, F upper, BoundsHandling handling = BoundsHandling::clamp) {
+    return [lower, upper, handling](const std::vector<std::vector<F>>& genes, G& generator) -> std::vector<std::vector<F>> {
+        std::vector<std::vector<F>> repaired_genes(genes);
+        for (std::vector<F>& gene : repaired_genes) {
+            apply_bounds(gene, lower, upper, handling);
+        }
+        return repaired_genes;
+    };
+}
@@ -1,6 +1,9 @@
+#pragma once
+
 #include <functional>
 #include <vector>
 #include <random>
+#include <cmath>
 
 // Evaluation Operators -------------------------------------------------------------
 
@@ -103,4 +106,71 @@ std::function<std::vector<std::vector<double>>(const std::vector<std::vector<int
         });
         return fitnesses;
     };
-}
\ No newline at end of file
+}
+
+/*
+    Sphere Evaluation: Assigns the negated sum of squares of the chromosomes of real-valued genes (maximum 0 at the origin)
+*/
+
+template<typename F>
+std::function<std::vector<double>(const std::vector<std::vector<F>>&)> evaluate_sphere() {
+    return [](const std::vector<std::vector<F>>& genes) -> std::vector<double> {
+        std::vector<double> fitnesses(genes.size());
+        for (size_t i = 0; i < genes.size(); i++) {
+            const F* x = genes[i].data();
+            double sum = 0;
+            #pragma omp simd reduction(+:sum)
+            for (size_t j = 0; j < genes[i].size(); j++) {
+                sum += (double) x[j] * x[j];
+            }
+            fitnesses[i] = -sum;
+        }
+        return fitnesses;
+    };
+}
+
+/*
+    Rastrigin Evaluation: Assigns the negated Rastrigin function 10 n + sum(x^2 - 10 cos(2 pi x)) of real-valued genes (maximum 0 at the origin)
+*/
+
+template<typename F>
+std::function<std::vector<double>(const std::vector<std::vector<F>>&)> evaluate_rastrigin() {
+    return [](const std::vector<std::vector<F>>& genes) -> std::vector<double> {
+        constexpr double two_pi = 6.283185307179586;
+        std::vector<double> fitnesses(genes.size());
+        for (size_t i = 0; i < genes.size(); i++) {
+            const F* x = genes[i].data();
+            double sum = 10.0 * genes[i].size();
+            #pragma omp simd reduction(+:sum)
+            for (size_t j = 0; j < genes[i].size(); j++) {
+                sum += (double) x[j] * x[j] - 10.0 * std::cos(two_pi * x[j]);
+            }
+            fitnesses[i] = -sum;
+        }
+        return fitnesses;
+    };
+}
+
+/*
+    Rosenbrock Evaluation: Assigns the negated Rosenbrock function sum(100 (x_j+1 - x_j^2)^2 + (1 - x_j)^2) of real-valued genes (maximum 0 at (1, ..., 1))
+*/
+
+template<typename F>
+std::function<std::vector<double>(const std::vector<std::vector<F>>&)> evaluate_rosenbrock() {
+    return [](const std::vector<std::vector<F>>& genes) -> std::vector<double> {
+        std::vector<double> fitnesses(genes.size());
+        for (size_t i = 0; i < genes.size(); i++) {
+            const F* x = genes[i].data();
+            size_t pairs_n = genes[i].empty() ? 0 : genes[i].size() - 1;
+            double sum = 0;
+            #pragma omp simd reduction(+:sum)
+            for (size_t j = 0; j < pairs_n; j++) {
+                double a = (double) x[j + 1] - (double) x[j] * x[j];
+                double b = 1.0 - x[j];
+                sum += 100.0 * a * a + b * b;
+            }
+            fitnesses[i] = -sum;
+        }
+        return fitnesses;
+    };
+}
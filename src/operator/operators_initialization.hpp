@@ -1,7 +1,11 @@
+#pragma once
+
 #include <functional>
 #include <vector>
 #include <random>
 
+#include "../random/random.hpp"
+
 //Initialization Operators ----------------------------------------------------------
 
 /*
@@ -12,16 +16,18 @@
         - chromosome_list:      list of possible values for each chromosome
 */
 
-std::function<std::vector<std::vector<int>>(std::mt19937&)> initialize_random(int population_size, int gene_length, const std::vector<int> chromosome_list) {
-    return [population_size, gene_length, chromosome_list](std::mt19937& generator) -> std::vector<std::vector<int>> {
+template<typename G = std::mt19937>
+std::function<std::vector<std::vector<int>>(G&)> initialize_random(int population_size, int gene_length, const std::vector<int> chromosome_list) {
+    return [population_size, gene_length, chromosome_list](G& generator) -> std::vector<std::vector<int>> {
         std::vector<std::vector<int>> genes(population_size);
-        std::uniform_int_distribution< int > distribute_chromosome(0, chromosome_list.size() - 1);
-        std::transform(genes.begin(), genes.end(), genes.begin(), [gene_length, chromosome_list, &generator, distribute_chromosome](std::vector<int>& gene) mutable -> std::vector<int> {
-            for (int i = 0; i < gene_length; i++) {
-                gene.emplace_back(chromosome_list[distribute_chromosome(generator)]);
-            }
-            return gene;
-        });
+        std::vector<int> indices(population_size * gene_length);
+        generate_uniform_int(generator, indices, 0, chromosome_list.size() - 1);
+        for (int i = 0; i < population_size; i++) {
+            genes[i].resize(gene_length);
+            std::transform(indices.begin() + i * gene_length, indices.begin() + (i + 1) * gene_length, genes[i].begin(), [&chromosome_list](int index) -> int {
+                return chromosome_list[index];
+            });
+        }
         return genes;
     };
 }
@@ -33,8 +39,9 @@ std::function<std::vector<std::vector<int>>(std::mt19937&)> initialize_random(in
         - chromosome_list:      elements of permutation
 */
 
-std::function<std::vector<std::vector<int>>(std::mt19937&)> initialize_random_permutation(int population_size, const std::vector<int> chromosome_list) {
-    return [population_size, chromosome_list](std::mt19937& generator) -> std::vector<std::vector<int>> {
+template<typename G = std::mt19937>
+std::function<std::vector<std::vector<int>>(G&)> initialize_random_permutation(int population_size, const std::vector<int> chromosome_list) {
+    return [population_size, chromosome_list](G& generator) -> std::vector<std::vector<int>> {
         std::vector<std::vector<int>> genes(population_size);
         std::transform(genes.begin(), genes.end(), genes.begin(), [chromosome_list, &generator](std::vector<int>& gene) -> std::vector<int> {
             gene = chromosome_list;
@@ -43,4 +50,26 @@ std::function<std::vector<std::vector<int>>(std::mt19937&)> initialize_random_pe
         });
         return genes;
     };
-}
\ No newline at end of file
+}
+
+/*
+    Uniform Real Initialization: Initialize real-valued genes of length gene_length with chromosomes uniformly distributed in [lower, upper)
+    Arguments:
+        - population_size:      number of genes in population
+        - gene_length:          number of chromosomes in gene
+        - lower:                lower bound of every chromosome
+        - upper:                upper bound of every chromosome
+*/
+
+template<typename F, typename G = std::mt19937>
+std::function<std::vector<std::vector<F>>(G&)> initialize_uniform_real(int population_size, int gene_length, F lower, F upper) {
+    return [population_size, gene_length, lower, upper](G& generator) -> std::vector<std::vector<F>> {
+        std::vector<std::vector<F>> genes(population_size);
+        std::vector<double> values((size_t) population_size * gene_length);
+        generate_uniform_real(generator, values, lower, upper);
+        for (int i = 0; i < population_size; i++) {
+            genes[i].assign(values.begin() + (size_t) i * gene_length, values.begin() + (size_t) (i + 1) * gene_length);
+        }
+        return genes;
+    };
+}
@@ -1,6 +1,12 @@
+#pragma once
+
 #include <functional>
 #include <vector>
 #include <random>
+#include <cmath>
+
+#include "../random/random.hpp"
+#include "operators_bounds.hpp"
 
 // Mutation Operators ---------------------------------------------------------------
 
@@ -13,23 +19,24 @@
         - chromosome_min:       minimum value for a chromosome
 */
 
-std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, std::mt19937&)> mutate_numeric(double mutation_rate, double incrementation_rate, int chromosome_max, int chromosome_min) {
-    return [mutation_rate, incrementation_rate, chromosome_max, chromosome_min](const std::vector<std::vector<int>>& genes, std::mt19937& generator) -> std::vector<std::vector<int>> {
-        std::vector<std::vector<int>> mutated_genes(genes.size());
-        std::uniform_real_distribution< double > distribute_rate(0, 1);
-        std::uniform_int_distribution< int > distribute_point(0, genes[0].size() - 1);
-        std::transform(genes.begin(), genes.end(), mutated_genes.begin(), [mutation_rate, incrementation_rate, chromosome_max, chromosome_min, &generator, distribute_rate, distribute_point](const std::vector<int>& gene) mutable -> std::vector<int> {
-            std::vector<int> mutated_gene = gene;
-            if (distribute_rate(generator) < mutation_rate) {
-                int chromosome = distribute_point(generator);
-                if (distribute_rate(generator) < incrementation_rate) {
-                    mutated_gene[chromosome] = std::min(chromosome_max, mutated_gene[chromosome] + 1);
+template<typename G = std::mt19937>
+std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, G&)> mutate_numeric(double mutation_rate, double incrementation_rate, int chromosome_max, int chromosome_min) {
+    return [mutation_rate, incrementation_rate, chromosome_max, chromosome_min](const std::vector<std::vector<int>>& genes, G& generator) -> std::vector<std::vector<int>> {
+        std::vector<std::vector<int>> mutated_genes(genes);
+        std::vector<double> rates(2 * genes.size());
+        std::vector<int> points(genes.size());
+        generate_uniform_real(generator, rates);
+        generate_uniform_int(generator, points, 0, genes[0].size() - 1);
+        for (int i = 0; i < mutated_genes.size(); i++) {
+            if (rates[2*i] < mutation_rate) {
+                int chromosome = points[i];
+                if (rates[2*i + 1] < incrementation_rate) {
+                    mutated_genes[i][chromosome] = std::min(chromosome_max, mutated_genes[i][chromosome] + 1);
                 } else {
-                    mutated_gene[chromosome] = std::max(chromosome_min, mutated_gene[chromosome] - 1);
+                    mutated_genes[i][chromosome] = std::max(chromosome_min, mutated_genes[i][chromosome] - 1);
                 }
             }
-            return mutated_gene;
-        });
+        }
         return mutated_genes;
     };
 }
@@ -40,21 +47,19 @@ std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&
         - mutation_rate:        overall probability of a mutation occurring
 */
 
-std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, std::mt19937&)> mutate_swap(double mutation_rate) {
-    return [mutation_rate](const std::vector<std::vector<int>>& genes, std::mt19937& generator) -> std::vector<std::vector<int>> {
-        std::vector<std::vector<int>> mutated_genes(genes.size());
-        std::uniform_real_distribution< double > distribute_rate(0, 1);
-        std::uniform_int_distribution< int > distribute_point(0, genes[0].size() - 1 );
-        std::transform(genes.begin(), genes.end(), mutated_genes.begin(), [mutation_rate, &generator, distribute_rate, distribute_point](const std::vector<int>& gene) mutable -> std::vector<int> {
-            std::vector<int> mutated_gene = gene;
-            if (distribute_rate(generator) < mutation_rate) {
-                int chromosome1 = distribute_point(generator);
-                int chromosome2 = distribute_point(generator);
-                mutated_gene[chromosome1] = gene[chromosome2];
-                mutated_gene[chromosome2] = gene[chromosome1];
+template<typename G = std::mt19937>
+std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, G&)> mutate_swap(double mutation_rate) {
+    return [mutation_rate](const std::vector<std::vector<int>>& genes, G& generator) -> std::vector<std::vector<int>> {
+        std::vector<std::vector<int>> mutated_genes(genes);
+        std::vector<double> rates(genes.size());
+        std::vector<int> points(2 * genes.size());
+        generate_uniform_real(generator, rates);
+        generate_uniform_int(generator, points, 0, genes[0].size() - 1);
+        for (int i = 0; i < mutated_genes.size(); i++) {
+            if (rates[i] < mutation_rate) {
+                std::swap(mutated_genes[i][points[2*i]], mutated_genes[i][points[2*i + 1]]);
             }
-            return mutated_gene;
-        });
+        }
         return mutated_genes;
     };
 }
@@ -67,8 +72,9 @@ std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&
         - due_dates:        Points in time where every job is due
 */
 
-std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, std::mt19937&)> mutate_sigmablock(double mutation_rate, int sigma, std::vector<int> due_dates) {
-    return [mutation_rate, sigma, due_dates](const std::vector<std::vector<int>>& genes, std::mt19937& generator) -> std::vector<std::vector<int>> {
+template<typename G = std::mt19937>
+std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, G&)> mutate_sigmablock(double mutation_rate, int sigma, std::vector<int> due_dates) {
+    return [mutation_rate, sigma, due_dates](const std::vector<std::vector<int>>& genes, G& generator) -> std::vector<std::vector<int>> {
         std::vector<std::vector<int>> mutated_genes(genes.size());
         std::uniform_real_distribution< double > distribute_rate(0, 1);
         std::uniform_int_distribution< int > distribute_point(0, genes[0].size() - 2*sigma - 1 );
@@ -97,8 +103,9 @@ std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&
 
 */
 
-std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, std::mt19937&)> mutate_extsigmablock(double mutation_rate, int sigma, std::vector<int> due_dates) {
-    return [mutation_rate, sigma, due_dates](const std::vector<std::vector<int>>& genes, std::mt19937& generator) -> std::vector<std::vector<int>> {
+template<typename G = std::mt19937>
+std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, G&)> mutate_extsigmablock(double mutation_rate, int sigma, std::vector<int> due_dates) {
+    return [mutation_rate, sigma, due_dates](const std::vector<std::vector<int>>& genes, G& generator) -> std::vector<std::vector<int>> {
         std::vector<std::vector<int>> mutated_genes(genes.size());
         std::uniform_real_distribution< double > distribute_rate(0, 1);
         std::uniform_int_distribution< int > distribute_point(0, genes[0].size() - 1 );
@@ -125,4 +132,79 @@ std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&
         });
         return mutated_genes;
     };
-}
\ No newline at end of file
+}
+
+/*
+    Gaussian Mutation: Adds a normally distributed step to every chromosome of a real-valued gene with probability mutation_rate
+    Arguments:
+        - mutation_rate:    probability of a chromosome being mutated
+        - sigma:            standard deviation of the steps
+        - lower:            lower bound of every chromosome
+        - upper:            upper bound of every chromosome
+        - handling:         clamp or reflect chromosomes leaving the bounds
+*/
+
+template<typename F, typename G = std::mt19937>
+std::function<std::vector<std::vector<F>>(const std::vector<std::vector<F>>&, G&)> mutate_gaussian(double mutation_rate, double sigma, F lower, F upper, BoundsHandling handling = BoundsHandling::clamp) {
+    return [mutation_rate, sigma, lower, upper, handling](const std::vector<std::vector<F>>& genes, G& generator) -> std::vector<std::vector<F>> {
+        std::vector<std::vector<F>> mutated_genes(genes);
+        if (genes.empty()) {
+            return mutated_genes;
+        }
+        // the random numbers of the whole population are drawn at once, the loops then only select and add
+        size_t gene_length = genes[0].size();
+        std::vector<double> rates(genes.size() * gene_length);
+        std::vector<double> steps(genes.size() * gene_length);
+        generate_uniform_real(generator, rates);
+        generate_normal(generator, steps, 0.0, sigma);
+        for (size_t i = 0; i < mutated_genes.size(); i++) {
+            F* x = mutated_genes[i].data();
+            const double* rate = rates.data() + i * gene_length;
+            const double* step = steps.data() + i * gene_length;
+            for (size_t j = 0; j < gene_length; j++) {
+                x[j] += rate[j] < mutation_rate ? (F) step[j] : (F) 0;
+            }
+            apply_bounds(mutated_genes[i], lower, upper, handling);
+        }
+        return mutated_genes;
+    };
+}
+
+/*
+    Polynomial Mutation: Moves every chromosome of a real-valued gene with probability mutation_rate by a polynomially distributed fraction of
+    the range [lower, upper], larger eta make smaller steps more likely
+    Arguments:
+        - mutation_rate:    probability of a chromosome being mutated
+        - eta:              distribution index of the steps
+        - lower:            lower bound of every chromosome
+        - upper:            upper bound of every chromosome
+        - handling:         clamp or reflect chromosomes leaving the bounds
+*/
+
+template<typename F, typename G = std::mt19937>
+std::function<std::vector<std::vector<F>>(const std::vector<std::vector<F>>&, G&)> mutate_polynomial(double mutation_rate, double eta, F lower, F upper, BoundsHandling handling = BoundsHandling::clamp) {
+    return [mutation_rate, eta, lower, upper, handling](const std::vector<std::vector<F>>& genes, G& generator) -> std::vector<std::vector<F>> {
+        std::vector<std::vector<F>> mutated_genes(genes);
+        if (genes.empty()) {
+            return mutated_genes;
+        }
+        size_t gene_length = genes[0].size();
+        std::vector<double> rates(genes.size() * gene_length);
+        std::vector<double> points(genes.size() * gene_length);
+        generate_uniform_real(generator, rates);
+        generate_uniform_real(generator, points);
+        const double exponent = 1.0 / (eta + 1.0);
+        const double range = (double) upper - (double) lower;
+        for (size_t i = 0; i < mutated_genes.size(); i++) {
+            F* x = mutated_genes[i].data();
+            const double* rate = rates.data() + i * gene_length;
+            const double* point = points.data() + i * gene_length;
+            for (size_t j = 0; j < gene_length; j++) {
+                double delta = point[j] < 0.5 ? std::pow(2.0 * point[j], exponent) - 1.0 : 1.0 - std::pow(2.0 * (1.0 - point[j]), exponent);
+                x[j] += rate[j] < mutation_rate ? (F) (delta * range) : (F) 0;
+            }
+            apply_bounds(mutated_genes[i], lower, upper, handling);
+        }
+        return mutated_genes;
+    };
+}
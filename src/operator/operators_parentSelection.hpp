@@ -1,3 +1,5 @@
+#pragma once
+
 #include <functional>
 #include <vector>
 #include <random>
@@ -11,9 +13,9 @@
         - rank:            function taking a vector of genes and returning a vector of ranks
 */
 
-template<typename T, typename L>
-std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_tournament_rank(int tournament_size) {
-    return [tournament_size](const std::vector<T>& genes, const std::vector<L>& fitnesses, const std::vector<int>& ranks, std::mt19937& generator) -> std::vector<std::vector<int>> {
+template<typename T, typename L, typename G = std::mt19937>
+std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)> select_tournament_rank(int tournament_size) {
+    return [tournament_size](const std::vector<T>& genes, const std::vector<L>& fitnesses, const std::vector<int>& ranks, G& generator) -> std::vector<std::vector<int>> {
         std::vector<T> parents(genes.size());
         std::uniform_int_distribution< int > distribute_point(0, genes.size() - 1);
         std::transform(parents.begin(), parents.end(), parents.begin(), [&](T& parent) mutable -> T {
@@ -37,9 +39,9 @@ std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const
         - evaluate: function taking a vector of genes and returning a vector of fitnesses
 */
 
-template <typename T, typename L>
-std::function<std::vector<int>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_roulette() {
-    return [](const std::vector<T>& genes, const std::vector<L>& fitnesses, const std::vector<int>& ranks, std::mt19937& generator) -> std::vector<int> {
+template <typename T, typename L, typename G = std::mt19937>
+std::function<std::vector<int>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)> select_roulette() {
+    return [](const std::vector<T>& genes, const std::vector<L>& fitnesses, const std::vector<int>& ranks, G& generator) -> std::vector<int> {
         std::vector<T> selected_genes(fitnesses.size());
         double total_fitness = std::accumulate(fitnesses.begin(), fitnesses.end(), 0.0);
         std::vector<double> probabilities(fitnesses.size());
@@ -64,9 +66,9 @@ std::function<std::vector<int>(const std::vector<T>&, const std::vector<L>&, con
         - evaluate:        function taking a vector of genes and returning a vector of fitnesses
 */
 
-template<typename T, typename L>
-std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_tournament(int tournament_size) {
-    return [tournament_size](const std::vector<T>& genes, const std::vector<L>& fitnesses, const std::vector<int>& ranks, std::mt19937& generator) -> std::vector<T> {
+template<typename T, typename L, typename G = std::mt19937>
+std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)> select_tournament(int tournament_size) {
+    return [tournament_size](const std::vector<T>& genes, const std::vector<L>& fitnesses, const std::vector<int>& ranks, G& generator) -> std::vector<T> {
         std::vector<T> selected_genes(genes.size());
         std::uniform_int_distribution< int > distribute_point(0, genes.size() - 1 );
         std::transform(selected_genes.begin(), selected_genes.end(), selected_genes.begin(), [&](T& selected_gene) mutable -> T {
@@ -82,4 +84,28 @@ std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const
         });
         return selected_genes;
     };
-}
\ No newline at end of file
+}
+/*
+    Tournament Parent Index Selection: Take a random subgroup of a specified size and choose the index of the one with the highest fitness value,
+    selects parents_n indices per call, so the streaming execution can select the parents batch by batch (see Population::set_selectParentIndices)
+    Arguments:
+        - tournament_size: size of the chosen subgroup
+*/
+
+template<typename L, typename G = std::mt19937>
+std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, int, G&)> select_tournament_indices(int tournament_size) {
+    return [tournament_size](const std::vector<L>& fitnesses, const std::vector<int>& ranks, int parents_n, G& generator) -> std::vector<int> {
+        std::vector<int> selected_indices(parents_n);
+        std::uniform_int_distribution< int > distribute_point(0, fitnesses.size() - 1 );
+        for (int& selected_index : selected_indices) {
+            selected_index = distribute_point(generator);
+            for (int i = 1; i < tournament_size; i++) {
+                int rand_index = distribute_point(generator);
+                if (fitnesses[selected_index] < fitnesses[rand_index]) {
+                    selected_index = rand_index;
+                }
+            }
+        }
+        return selected_indices;
+    };
+}
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <random>
+#include <assert.h>
+
+#include "../population/streaming_selection.hpp"
+
+// Statistics of one operator of a portfolio
+struct OperatorStatistics{
+    std::string name;
+    long applications;      // number of times the operator was applied
+    double time;            // seconds spent in the operator
+    double improvement;     // summed fitness improvement of the operator's output genes over the worst survivor
+    double weight;          // discounted number of credited applications used by the bandit
+    double rate;            // discounted improvement per second used by the bandit
+};
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+/*
+    Class for an adaptive portfolio of operators with the signature of mutation and recombination (genes of type T, random engine of type G).
+    On every application one operator is chosen by a UCB1 bandit maximizing the fitness improvement per second. The portfolio evaluates
+    nothing itself: it remembers the chosen operator, its wall-clock time and the number of output genes of every application, and the
+    survivor selection credits the applications in order with the fitness values of the offspring it evaluates anyway (see select_crediting),
+    as the summed positive difference between the fitness of each output gene and the worst survivor, so only output genes entering the next
+    generation count. Several portfolios
+    applied one after the other (e.g. recombination and mutation) are all credited with the same offspring. Older observations are
+    discounted by the factor discount per credited application, so the choice follows changes during a run.
+*/
+template<typename T, typename G = std::mt19937>
+class OperatorPortfolio{
+
+private:
+
+    // application waiting for the fitness values of its output genes
+    struct Application{
+        int chosen;
+        double time;
+        int genes_n;
+    };
+
+    std::vector<std::function<std::vector<T>(const std::vector<T>&, G&)>> operators;
+    std::vector<OperatorStatistics> statistics;
+    std::deque<Application> pending;
+    double exploration;
+    double discount;
+    std::mutex mutex;
+
+    int choose();
+
+public:
+
+    OperatorPortfolio(double exploration = 0.5, double discount = 0.99);
+
+    void add(const std::string& name, const std::function<std::vector<T>(const std::vector<T>&, G&)>& op); //adds an operator to the portfolio
+    std::vector<T> apply(const std::vector<T>& genes, G& generator); //applies one operator chosen by the bandit, its improvement is credited later
+    void credit(const std::vector<double>& fitnesses, double baseline); //credits the pending applications in order with the fitness values of their output genes
+    std::vector<OperatorStatistics> get_statistics(); //returns the statistics of all operators
+    std::string to_string(); //returns the statistics as csv lines
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+template<typename T, typename G>
+OperatorPortfolio<T, G>::OperatorPortfolio(double exploration, double discount) : exploration(exploration), discount(discount) {}
+
+template<typename T, typename G>
+void OperatorPortfolio<T, G>::add(const std::string& name, const std::function<std::vector<T>(const std::vector<T>&, G&)>& op){
+    std::lock_guard<std::mutex> lock(mutex);
+    operators.emplace_back(op);
+    statistics.emplace_back(OperatorStatistics{name, 0, 0, 0, 0, 0});
+}
+
+// Untried operators are chosen first, afterwards the one with the highest upper confidence bound of its improvement rate relative to the best rate
+template<typename T, typename G>
+int OperatorPortfolio<T, G>::choose(){
+    std::lock_guard<std::mutex> lock(mutex);
+    assert(!operators.empty());
+    double total_weight = 0;
+    double best_rate = 0;
+    for(int i = 0; i < statistics.size(); i++){
+        if(statistics[i].applications == 0){
+            return i;
+        }
+        total_weight += statistics[i].weight;
+        best_rate = std::max(best_rate, statistics[i].rate);
+    }
+    int chosen = 0;
+    double chosen_bound = -std::numeric_limits<double>::infinity();
+    for(int i = 0; i < statistics.size(); i++){
+        double normalized_rate = best_rate > 0 ? statistics[i].rate / best_rate : 0;
+        double bound = normalized_rate + exploration * std::sqrt(2 * std::log(std::max(1.0, total_weight)) / statistics[i].weight);
+        if(bound > chosen_bound){
+            chosen = i;
+            chosen_bound = bound;
+        }
+    }
+    return chosen;
+}
+
+template<typename T, typename G>
+std::vector<T> OperatorPortfolio<T, G>::apply(const std::vector<T>& genes, G& generator){
+    int chosen = choose();
+    auto start = std::chrono::steady_clock::now();
+    std::vector<T> result = operators[chosen](genes, generator);
+    double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::lock_guard<std::mutex> lock(mutex);
+    statistics[chosen].applications++;
+    statistics[chosen].time += time;
+    pending.emplace_back(Application{chosen, time, (int) result.size()});
+    return result;
+}
+
+template<typename T, typename G>
+void OperatorPortfolio<T, G>::credit(const std::vector<double>& fitnesses, double baseline){
+    std::lock_guard<std::mutex> lock(mutex);
+    int offset = 0;
+    while(!pending.empty() && offset < fitnesses.size()){
+        const Application& application = pending.front();
+        double improvement = 0;
+        int end = std::min((int) fitnesses.size(), offset + application.genes_n);
+        for(; offset < end; offset++){
+            improvement += std::max(0.0, fitnesses[offset] - baseline);
+        }
+        for(OperatorStatistics& operator_statistics : statistics){
+            operator_statistics.weight *= discount;
+        }
+        OperatorStatistics& operator_statistics = statistics[application.chosen];
+        double rate = improvement / std::max(application.time, 1e-9);
+        operator_statistics.rate = (operator_statistics.rate * operator_statistics.weight + rate) / (operator_statistics.weight + 1);
+        operator_statistics.weight += 1;
+        operator_statistics.improvement += improvement;
+        pending.pop_front();
+    }
+    // applications whose output was not passed (e.g. offspring dropped before the selection) are never credited
+    pending.clear();
+}
+
+template<typename T, typename G>
+std::vector<OperatorStatistics> OperatorPortfolio<T, G>::get_statistics(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return statistics;
+}
+
+template<typename T, typename G>
+std::string OperatorPortfolio<T, G>::to_string(){
+    std::string s = "name,applications,time,improvement,improvement_per_second\n";
+    for(const OperatorStatistics& operator_statistics : get_statistics()){
+        double rate = operator_statistics.time > 0 ? operator_statistics.improvement / operator_statistics.time : 0;
+        s += operator_statistics.name + "," + std::to_string(operator_statistics.applications) + "," + std::to_string(operator_statistics.time) + ","
+            + std::to_string(operator_statistics.improvement) + "," + std::to_string(rate) + "\n";
+    }
+    return s;
+}
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+// Streaming survivor selection crediting portfolios with every offered batch against the worst gene of the next generation at its begin, before passing the batch to the wrapped streaming selection
+template<typename T, typename G = std::mt19937>
+class StreamingCrediting : public StreamingSurvivorSelection<double>{
+
+private:
+
+    std::vector<std::shared_ptr<OperatorPortfolio<T, G>>> portfolios;
+    std::shared_ptr<StreamingSurvivorSelection<double>> select;
+    double baseline;
+
+public:
+
+    StreamingCrediting(const std::vector<std::shared_ptr<OperatorPortfolio<T, G>>>& portfolios, const std::shared_ptr<StreamingSurvivorSelection<double>>& select);
+
+    std::vector<int> begin(const std::vector<double>& fitnesses, const std::vector<int>& ranks) override;
+    std::vector<int> offer(const std::vector<double>& fitnesses) override;
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+template<typename T, typename G>
+StreamingCrediting<T, G>::StreamingCrediting(const std::vector<std::shared_ptr<OperatorPortfolio<T, G>>>& portfolios, const std::shared_ptr<StreamingSurvivorSelection<double>>& select)
+    : portfolios(portfolios), select(select), baseline(0) {
+    assert(select != nullptr);
+}
+
+template<typename T, typename G>
+std::vector<int> StreamingCrediting<T, G>::begin(const std::vector<double>& fitnesses, const std::vector<int>& ranks){
+    std::vector<int> sources = select->begin(fitnesses, ranks);
+    // the worst gene the next generation starts with, the survival threshold can only rise while offspring are offered
+    baseline = std::numeric_limits<double>::infinity();
+    for(int source : sources){
+        baseline = std::min(baseline, source >= 0 ? fitnesses[source] : -std::numeric_limits<double>::infinity());
+    }
+    return sources;
+}
+
+template<typename T, typename G>
+std::vector<int> StreamingCrediting<T, G>::offer(const std::vector<double>& fitnesses){
+    for(const std::shared_ptr<OperatorPortfolio<T, G>>& portfolio : portfolios){
+        portfolio->credit(fitnesses, baseline);
+    }
+    return select->offer(fitnesses);
+}
+
+// Portfolio Operators --------------------------------------------------------------
+
+/*
+    Portfolio Operator: Applies an operator of the portfolio chosen by the bandit, can be passed as mutation or recombination
+    Arguments:
+        - portfolio:    portfolio of operators, shared with the caller to read the statistics
+*/
+
+template<typename T, typename G = std::mt19937>
+std::function<std::vector<T>(const std::vector<T>&, G&)> apply_portfolio(std::shared_ptr<OperatorPortfolio<T, G>> portfolio) {
+    return [portfolio](const std::vector<T>& genes, G& generator) -> std::vector<T> {
+        return portfolio->apply(genes, generator);
+    };
+}
+
+/*
+    Crediting Selection: Index based survivor selection (see Population::set_selectSurvivorIndices) crediting the portfolios with the fitness
+    values of the offspring, which the population evaluates for the selection anyway, before passing them to the wrapped selection
+    Arguments:
+        - portfolios:   portfolios applied to create the offspring
+        - select:       index based survivor selection, e.g. select_mu_indices
+*/
+
+template<typename T, typename G = std::mt19937>
+std::function<std::vector<int>(const std::vector<double>&, const std::vector<int>&, const std::vector<double>&, G&)> select_crediting(
+    std::vector<std::shared_ptr<OperatorPortfolio<T, G>>> portfolios,
+    std::function<std::vector<int>(const std::vector<double>&, const std::vector<int>&, const std::vector<double>&, G&)> select
+) {
+    return [portfolios, select](const std::vector<double>& fitnesses_parents, const std::vector<int>& ranks_parents, const std::vector<double>& fitnesses_children, G& generator) mutable -> std::vector<int> {
+        std::vector<int> survivors = select(fitnesses_parents, ranks_parents, fitnesses_children, generator);
+        // offspring are credited with how far they exceed the worst survivor, so only offspring entering the next generation count
+        double baseline = std::numeric_limits<double>::infinity();
+        for (int survivor : survivors) {
+            baseline = std::min(baseline, survivor < fitnesses_parents.size() ? fitnesses_parents[survivor] : fitnesses_children[survivor - fitnesses_parents.size()]);
+        }
+        for (const std::shared_ptr<OperatorPortfolio<T, G>>& portfolio : portfolios) {
+            portfolio->credit(fitnesses_children, baseline);
+        }
+        return survivors;
+    };
+}
+
+/*
+    Streaming Crediting Selection: Like select_crediting for the streaming execution (see Population::set_selectSurvivorsStreaming), credits the
+    portfolios with every batch of offspring
+    Arguments:
+        - portfolios:   portfolios applied to create the offspring
+        - select:       streaming survivor selection, e.g. select_mu_streaming
+*/
+
+template<typename T, typename G = std::mt19937>
+std::shared_ptr<StreamingSurvivorSelection<double>> select_crediting_streaming(
+    std::vector<std::shared_ptr<OperatorPortfolio<T, G>>> portfolios,
+    std::shared_ptr<StreamingSurvivorSelection<double>> select
+) {
+    return std::make_shared<StreamingCrediting<T, G>>(portfolios, select);
+}
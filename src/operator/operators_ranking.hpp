@@ -1,56 +1,151 @@
+#pragma once
+
 #include <functional>
 #include <vector>
 #include <random>
+#include <numeric>
+#include <algorithm>
 
-// Ranking Operators-----------------------------------------------------------------
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
 
 /*
-    Pareto Ranking - Ranks vectors of fitness values based on pareto optimality
+    Class for nondominated sorting of fitness vectors of type L (all objectives maximized) with the efficient nondominated sort using binary
+    search (ENS-BS): the points are visited in lexicographically descending order, so a point can only be dominated by points visited before
+    it, and each point is appended to the first front none of whose members dominates it, found by binary search over the fronts.
+    The fitness vectors of two vectors are sorted as one (indices of the second one follow the ones of the first one), so parents and
+    offspring never have to be copied together. The buffers are kept between calls, so sorting allocates nothing once they have grown.
 */
 template<typename L>
-std::function<std::vector<int>(const std::vector<L>&)> rank_pareto() {
-    return [](const std::vector<L>& fitnesses) -> std::vector<int> {
-        auto dominates = ([](L p1, L p2) -> bool {
-            for(int i = 0; i < p1.size(); i++){
-                if(p1[i] < p2[i]){
-                    return false;
-                }
+class ParetoSorter{
+
+private:
+
+    std::vector<int> order;
+    std::vector<typename L::value_type> values;
+    std::vector<std::vector<int>> fronts;
+    int fronts_n;
+    std::vector<int> ranks;
+
+public:
+
+    ParetoSorter();
+
+    void sort(const std::vector<L>& first, const std::vector<L>& second); //sorts the fitness vectors of first followed by the ones of second
+    int get_fronts_n(); //returns the number of fronts of the last sort
+    const std::vector<int>& get_front(int front); //returns the indices of the points in a front (0 is the nondominated front)
+    const std::vector<int>& get_ranks(); //returns the rank of every point, starting with 1 for the nondominated front
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+template<typename L>
+ParetoSorter<L>::ParetoSorter() : fronts_n(0) {}
+
+template<typename L>
+void ParetoSorter<L>::sort(const std::vector<L>& first, const std::vector<L>& second){
+    auto fitness = [&](int index) -> const L& {
+        return index < first.size() ? first[index] : second[index - first.size()];
+    };
+    int n = first.size() + second.size();
+    int objectives_n = n > 0 ? fitness(0).size() : 0;
+    order.resize(n);
+    ranks.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        const L& fa = fitness(a);
+        const L& fb = fitness(b);
+        return fa > fb || (fa == fb && a < b);
+    });
+    // the fitness values are copied in sorted order into one contiguous buffer, so the dominance checks run over adjacent memory
+    values.resize((size_t) n * objectives_n);
+    for(int k = 0; k < n; k++){
+        std::copy(fitness(order[k]).begin(), fitness(order[k]).end(), values.begin() + (size_t) k * objectives_n);
+    }
+    // the point at sorted position p1 dominates the one at p2 > p1 if it is at least as good in every objective and better in one
+    auto dominates = [&](int p1, int p2) -> bool {
+        const auto* v1 = values.data() + (size_t) p1 * objectives_n;
+        const auto* v2 = values.data() + (size_t) p2 * objectives_n;
+        bool better = false;
+        for(int i = 0; i < objectives_n; i++){
+            if(v1[i] < v2[i]){
+                return false;
+            }
+            better = better || v1[i] > v2[i];
+        }
+        return better;
+    };
+    for(int f = 0; f < fronts_n; f++){
+        fronts[f].clear();
+    }
+    fronts_n = 0;
+    for(int k = 0; k < n; k++){
+        // members of a front are visited from the last added one, which is the most likely to dominate the point; with two objectives
+        // the last added member has the largest second objective of its front, so it dominates the point if any member does
+        auto dominated = [&](int f) -> bool {
+            const std::vector<int>& front = fronts[f];
+            if(objectives_n == 2){
+                return dominates(front.back(), k);
             }
-            return true;
-        });
-        std::vector<int> ranks(fitnesses.size(), 0);
-        std::vector<int> n(fitnesses.size(), 0);
-        std::vector<std::vector<int>> S(fitnesses.size(), std::vector<int>{});
-        std::vector<std::vector<int>> F = {{}};
-        for(int i = 0; i < fitnesses.size(); i++){
-            for(int j = 0; j < fitnesses.size(); j++){
-                if(i == j) continue;
-                if(dominates(fitnesses[i], fitnesses[j])){
-                    S[i].push_back(j);
-                } else if(dominates(fitnesses[j], fitnesses[i])){
-                    n[i]++;
+            for(auto it = front.rbegin(); it != front.rend(); ++it){
+                if(dominates(*it, k)){
+                    return true;
                 }
             }
-            if(n[i] == 0){
-                ranks[i] = 1;
-                F[0].push_back(i);
+            return false;
+        };
+        int low = 0;
+        int high = fronts_n;
+        while(low < high){
+            int middle = (low + high) / 2;
+            if(dominated(middle)){
+                low = middle + 1;
+            }else{
+                high = middle;
             }
         }
-        int i = 0;
-        while(!F[i].empty()){
-            std::vector<int> Q = {};
-            for(auto p : F[i]){
-                for(auto q : S[p]){
-                    n[q]--;
-                    if(n[q] == 0){
-                        ranks[q] = i + 2;
-                        Q.push_back(q);
-                    }
-                }
+        if(low == fronts_n){
+            if(fronts.size() == fronts_n){
+                fronts.emplace_back();
             }
-            i++;
-            F.push_back(Q);
+            fronts_n++;
         }
-        return ranks;
+        fronts[low].emplace_back(k);
+        ranks[order[k]] = low + 1;
+    }
+    // the fronts hold sorted positions while sorting, afterwards they hold the indices of the points
+    for(int f = 0; f < fronts_n; f++){
+        for(int& member : fronts[f]){
+            member = order[member];
+        }
+    }
+}
+
+template<typename L>
+int ParetoSorter<L>::get_fronts_n(){
+    return fronts_n;
+}
+
+template<typename L>
+const std::vector<int>& ParetoSorter<L>::get_front(int front){
+    return fronts[front];
+}
+
+template<typename L>
+const std::vector<int>& ParetoSorter<L>::get_ranks(){
+    return ranks;
+}
+
+// Ranking Operators-----------------------------------------------------------------
+
+/*
+    Pareto Ranking - Ranks vectors of fitness values based on pareto optimality
+    The operator keeps its ParetoSorter between calls, so it must not be called by several threads at once; every thread needs its own copy
+*/
+template<typename L>
+std::function<std::vector<int>(const std::vector<L>&)> rank_pareto() {
+    return [sorter = ParetoSorter<L>()](const std::vector<L>& fitnesses) mutable -> std::vector<int> {
+        sorter.sort(fitnesses, {});
+        return sorter.get_ranks();
     };
-}
\ No newline at end of file
+}
@@ -1,6 +1,12 @@
+#pragma once
+
 #include <functional>
 #include <vector>
 #include <random>
+#include <cmath>
+
+#include "../random/random.hpp"
+#include "operators_bounds.hpp"
 
 // Recombination Operators ----------------------------------------------------------
 
@@ -8,8 +14,9 @@
     Midpoint Recombination: Takes the first half of the gene of the first parents gene and the second half of the second parents gene to create a new gene, parents are the pairs of genes iterating the list of genes
 */
 
-std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, std::mt19937&)> recombine_midpoint() { 
-    return [](const std::vector<std::vector<int>>& parents, std::mt19937& generator) -> std::vector<std::vector<int>> {
+template<typename G = std::mt19937>
+std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, G&)> recombine_midpoint() { 
+    return [](const std::vector<std::vector<int>>& parents, G& generator) -> std::vector<std::vector<int>> {
         std::vector<std::vector<int>> children(parents.size());
         int procreations_n = parents.size() % 2 == 0 ? parents.size() : parents.size()-1;
         for(int i = 0; i < procreations_n; i++){
@@ -32,8 +39,9 @@ std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&
     Twopoint Recombination: Takes a segment of the first parent and adds it to the childs gene. Then it fills out the residual chromosomes in the order of the second parent.
 */
 
-std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, std::mt19937&)> recombine_twopoint() { 
-    return [](const std::vector<std::vector<int>>& parents, std::mt19937& generator) -> std::vector<std::vector<int>> {
+template<typename G = std::mt19937>
+std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&, G&)> recombine_twopoint() { 
+    return [](const std::vector<std::vector<int>>& parents, G& generator) -> std::vector<std::vector<int>> {
         std::vector<std::vector<int>> children(parents.size());
         int procreations_n = parents.size() % 2 == 0 ? parents.size() : parents.size()-1;
         std::uniform_int_distribution< int > distribute_point1(0, parents[0].size() - 2);
@@ -66,4 +74,82 @@ std::function<std::vector<std::vector<int>>(const std::vector<std::vector<int>>&
         }
         return children;
     };
-};
\ No newline at end of file
+};
+
+/*
+    Simulated Binary Recombination (SBX): Creates two children from every pair of real-valued parents (the pairs of genes iterating the list
+    of genes) which are spread around them like the children of a one point crossover of binary genes, larger eta keep them closer to the parents
+    Arguments:
+        - eta:      distribution index of the spread
+        - lower:    lower bound of every chromosome
+        - upper:    upper bound of every chromosome
+        - handling: clamp or reflect chromosomes leaving the bounds
+*/
+
+template<typename F, typename G = std::mt19937>
+std::function<std::vector<std::vector<F>>(const std::vector<std::vector<F>>&, G&)> recombine_sbx(double eta, F lower, F upper, BoundsHandling handling = BoundsHandling::clamp) {
+    return [eta, lower, upper, handling](const std::vector<std::vector<F>>& parents, G& generator) -> std::vector<std::vector<F>> {
+        std::vector<std::vector<F>> children(parents);
+        if (parents.size() < 2) {
+            return children;
+        }
+        size_t gene_length = parents[0].size();
+        std::vector<double> points(parents.size() / 2 * gene_length);
+        generate_uniform_real(generator, points);
+        const double exponent = 1.0 / (eta + 1.0);
+        for (size_t i = 0; i + 1 < parents.size(); i += 2) {
+            const F* p1 = parents[i].data();
+            const F* p2 = parents[i + 1].data();
+            F* c1 = children[i].data();
+            F* c2 = children[i + 1].data();
+            const double* point = points.data() + i / 2 * gene_length;
+            for (size_t j = 0; j < gene_length; j++) {
+                double beta = point[j] <= 0.5 ? std::pow(2.0 * point[j], exponent) : std::pow(0.5 / (1.0 - point[j]), exponent);
+                c1[j] = (F) (0.5 * ((1.0 + beta) * p1[j] + (1.0 - beta) * p2[j]));
+                c2[j] = (F) (0.5 * ((1.0 - beta) * p1[j] + (1.0 + beta) * p2[j]));
+            }
+            apply_bounds(children[i], lower, upper, handling);
+            apply_bounds(children[i + 1], lower, upper, handling);
+        }
+        return children;
+    };
+}
+
+/*
+    Blend Recombination (BLX-alpha): Creates two children from every pair of real-valued parents (the pairs of genes iterating the list of genes),
+    every chromosome is drawn uniformly from the interval between the parents' chromosomes extended by alpha times its length on both sides
+    Arguments:
+        - alpha:    extension of the interval
+        - lower:    lower bound of every chromosome
+        - upper:    upper bound of every chromosome
+        - handling: clamp or reflect chromosomes leaving the bounds
+*/
+
+template<typename F, typename G = std::mt19937>
+std::function<std::vector<std::vector<F>>(const std::vector<std::vector<F>>&, G&)> recombine_blend(double alpha, F lower, F upper, BoundsHandling handling = BoundsHandling::clamp) {
+    return [alpha, lower, upper, handling](const std::vector<std::vector<F>>& parents, G& generator) -> std::vector<std::vector<F>> {
+        std::vector<std::vector<F>> children(parents);
+        if (parents.size() < 2) {
+            return children;
+        }
+        size_t gene_length = parents[0].size();
+        // child = p1 + w * (p2 - p1) with w uniform in [-alpha, 1 + alpha] covers the extended interval for either order of the parents
+        std::vector<double> weights(parents.size() / 2 * 2 * gene_length);
+        generate_uniform_real(generator, weights, -alpha, 1.0 + alpha);
+        for (size_t i = 0; i + 1 < parents.size(); i += 2) {
+            const F* p1 = parents[i].data();
+            const F* p2 = parents[i + 1].data();
+            F* c1 = children[i].data();
+            F* c2 = children[i + 1].data();
+            const double* w1 = weights.data() + i * gene_length;
+            const double* w2 = w1 + gene_length;
+            for (size_t j = 0; j < gene_length; j++) {
+                c1[j] = (F) (p1[j] + w1[j] * (p2[j] - p1[j]));
+                c2[j] = (F) (p1[j] + w2[j] * (p2[j] - p1[j]));
+            }
+            apply_bounds(children[i], lower, upper, handling);
+            apply_bounds(children[i + 1], lower, upper, handling);
+        }
+        return children;
+    };
+}
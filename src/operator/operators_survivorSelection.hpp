@@ -1,33 +1,389 @@
+#pragma once
+
 #include <functional>
 #include <vector>
 #include <random>
+#include <numeric>
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <memory>
+#include <assert.h>
+
+#include "operators_ranking.hpp"
+#include "../population/streaming_selection.hpp"
+#include "../indicator/hypervolume.hpp"
 
 // Survivor selection operators ----------------------------------------------------
 
+/*
+    Every survivor selection exists in two forms: one taking the genes of parents and offspring and evaluating the offspring, and one taking
+    only the fitness values of parents and offspring and returning the indices of the survivors (indices below the number of parents refer
+    to parents, the others to offspring). Population::set_selectSurvivorIndices uses the second one, so the population evaluates the
+    offspring itself and keeps the fitness values of the survivors for the next generation instead of evaluating them again.
+    The selections sorting by Pareto fronts keep their ParetoSorter and buffers in the operator, so they only allocate during the first
+    generations; a std::function holding them must therefore not be called by several threads at once, every thread (e.g. every run of an
+    Experiment) needs its own copy.
+*/
+
+// Returns the selected genes of the combined population of parents and offspring
+template<typename T>
+std::vector<T> gather_survivors(const std::vector<int>& indices, const std::vector<T>& parents, const std::vector<T>& offspring) {
+    std::vector<T> selected_genes(indices.size());
+    for (int i = 0; i < indices.size(); i++) {
+        selected_genes[i] = indices[i] < parents.size() ? parents[indices[i]] : offspring[indices[i] - parents.size()];
+    }
+    return selected_genes;
+}
+
 /*
     mu-Selection: Selects the best mu individuals from the combined population of parents and offspring
     Arguments:
         - mu:       number of individuals to select
-        - evaluate: function taking a vector of genes and returning a vector of fitnesses
 */
 
-template<typename T, typename L>
-std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)> select_mu(int mu, std::function<std::vector<L>(const std::vector<T>&)> evaluate) {
-    return [mu, evaluate](const std::vector<T>& parents, const std::vector<L>& fitnesses_parents, const std::vector<int>& ranks_parents, const std::vector<T>& offspring, std::mt19937& generator) -> std::vector<T> {
-        std::vector<T> combined = parents;
-        combined.insert(combined.end(), offspring.begin(), offspring.end());
-        std::vector<L> fitnesses = fitnesses_parents;
-        std::vector<L> fitnesses_children = evaluate(offspring);
-        fitnesses.insert(fitnesses.end(), fitnesses_children.begin(), fitnesses_children.end());
-        std::vector<T> selected_genes(mu);
-        std::vector<int> indices(combined.size());
+template<typename L, typename G = std::mt19937>
+std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, const std::vector<L>&, G&)> select_mu_indices(int mu) {
+    return [mu](const std::vector<L>& fitnesses_parents, const std::vector<int>& ranks_parents, const std::vector<L>& fitnesses_children, G& generator) -> std::vector<int> {
+        // indices below fitnesses_parents.size() refer to parents, the others to offspring, so the combined population is never copied
+        auto fitness = [&](int index) -> const L& {
+            return index < fitnesses_parents.size() ? fitnesses_parents[index] : fitnesses_children[index - fitnesses_parents.size()];
+        };
+        std::vector<int> indices(fitnesses_parents.size() + fitnesses_children.size());
         std::iota(indices.begin(), indices.end(), 0);
-        std::partial_sort(indices.begin(), indices.begin() + mu, indices.end(), [&](int a, int b) {
-            return fitnesses[a] > fitnesses[b];
+        int count = std::min(mu, (int) indices.size());
+        std::partial_sort(indices.begin(), indices.begin() + count, indices.end(), [&](int a, int b) {
+            return fitness(a) > fitness(b);
         });
-        for (int i = 0; i < mu; i++) {
-            selected_genes[i] = combined[indices[i]];
+        indices.resize(count);
+        return indices;
+    };
+}
+
+/*
+    mu-Selection: Like select_mu_indices, evaluating the offspring and returning the selected genes
+    Arguments:
+        - mu:       number of individuals to select
+        - evaluate: function taking a vector of genes and returning a vector of fitnesses
+*/
+
+template<typename T, typename L, typename G = std::mt19937>
+std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)> select_mu(int mu, std::function<std::vector<L>(const std::vector<T>&)> evaluate) {
+    return [evaluate, select = select_mu_indices<L, G>(mu)](const std::vector<T>& parents, const std::vector<L>& fitnesses_parents, const std::vector<int>& ranks_parents, const std::vector<T>& offspring, G& generator) -> std::vector<T> {
+        return gather_survivors(select(fitnesses_parents, ranks_parents, evaluate(offspring), generator), parents, offspring);
+    };
+}
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+/*
+    Class for the mu-selection in the streaming execution: the slots start with the best mu current genes (empty slots if there are fewer),
+    and an offered offspring takes over the slot with the worst fitness value if it is better (by operator>, like select_mu), found on
+    a heap, so the survivors are the same as the ones of select_mu over the current genes and all offspring
+*/
+template<typename L>
+class StreamingMuSelection : public StreamingSurvivorSelection<L>{
+
+private:
+
+    int mu;
+    std::vector<L> slot_fitnesses;
+    std::vector<bool> empty;
+    std::vector<int> heap; // slots with the worst (or an empty) one on top
+
+    bool better(int a, int b);
+
+public:
+
+    explicit StreamingMuSelection(int mu);
+
+    std::vector<int> begin(const std::vector<L>& fitnesses, const std::vector<int>& ranks) override;
+    std::vector<int> offer(const std::vector<L>& fitnesses) override;
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+template<typename L>
+StreamingMuSelection<L>::StreamingMuSelection(int mu) : mu(mu) {
+    assert(mu > 0);
+}
+
+template<typename L>
+bool StreamingMuSelection<L>::better(int a, int b){
+    return !empty[a] && (empty[b] || slot_fitnesses[a] > slot_fitnesses[b]);
+}
+
+template<typename L>
+std::vector<int> StreamingMuSelection<L>::begin(const std::vector<L>& fitnesses, const std::vector<int>& ranks){
+    std::vector<int> indices(fitnesses.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    int count = std::min(mu, (int) indices.size());
+    std::partial_sort(indices.begin(), indices.begin() + count, indices.end(), [&](int a, int b) {
+        return fitnesses[a] > fitnesses[b];
+    });
+    indices.resize(mu, -1);
+    slot_fitnesses.assign(mu, L());
+    empty.assign(mu, true);
+    for(int slot = 0; slot < count; slot++){
+        slot_fitnesses[slot] = fitnesses[indices[slot]];
+        empty[slot] = false;
+    }
+    heap.resize(mu);
+    std::iota(heap.begin(), heap.end(), 0);
+    std::make_heap(heap.begin(), heap.end(), [this](int a, int b) { return better(a, b); });
+    return indices;
+}
+
+template<typename L>
+std::vector<int> StreamingMuSelection<L>::offer(const std::vector<L>& fitnesses){
+    std::vector<int> slots(fitnesses.size(), -1);
+    auto compare = [this](int a, int b) { return better(a, b); };
+    for(int i = 0; i < fitnesses.size(); i++){
+        int worst = heap.front();
+        if(empty[worst] || fitnesses[i] > slot_fitnesses[worst]){
+            std::pop_heap(heap.begin(), heap.end(), compare);
+            slot_fitnesses[worst] = fitnesses[i];
+            empty[worst] = false;
+            std::push_heap(heap.begin(), heap.end(), compare);
+            slots[i] = worst;
         }
-        return selected_genes;
+    }
+    return slots;
+}
+
+/*
+    Streaming mu-Selection: The mu-selection for the streaming execution (see Population::set_selectSurvivorsStreaming)
+    Arguments:
+        - mu:       number of individuals to select
+*/
+
+template<typename L>
+std::shared_ptr<StreamingSurvivorSelection<L>> select_mu_streaming(int mu) {
+    return std::make_shared<StreamingMuSelection<L>>(mu);
+}
+
+/*
+    NSGA-II Selection: Selects the best mu individuals from the combined population of parents and offspring for multiple objectives, front by
+    front of the nondominated sorting, and the individuals of the front which does not fit completely by their crowding distance
+    Arguments:
+        - mu:       number of individuals to select
+*/
+
+template<typename L, typename G = std::mt19937>
+std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, const std::vector<L>&, G&)> select_nsga2_indices(int mu) {
+    return [mu, sorter = ParetoSorter<L>(), selected = std::vector<int>(), last = std::vector<int>(), distances = std::vector<double>()](
+        const std::vector<L>& fitnesses_parents, const std::vector<int>& ranks_parents, const std::vector<L>& fitnesses_children, G& generator
+    ) mutable -> std::vector<int> {
+        auto fitness = [&](int index) -> const L& {
+            return index < fitnesses_parents.size() ? fitnesses_parents[index] : fitnesses_children[index - fitnesses_parents.size()];
+        };
+        sorter.sort(fitnesses_parents, fitnesses_children);
+        int count = std::min(mu, (int) (fitnesses_parents.size() + fitnesses_children.size()));
+        selected.clear();
+        int f = 0;
+        for (; selected.size() < count && selected.size() + sorter.get_front(f).size() <= count; f++) {
+            selected.insert(selected.end(), sorter.get_front(f).begin(), sorter.get_front(f).end());
+        }
+        if (selected.size() < count) {
+            // crowding distance of the last front: one sort per objective, the extreme points of every objective are always kept
+            last.assign(sorter.get_front(f).begin(), sorter.get_front(f).end());
+            distances.assign(fitnesses_parents.size() + fitnesses_children.size(), 0);
+            for (int objective = 0; objective < fitness(last[0]).size(); objective++) {
+                std::sort(last.begin(), last.end(), [&](int a, int b) {
+                    return fitness(a)[objective] < fitness(b)[objective];
+                });
+                double range = fitness(last.back())[objective] - fitness(last.front())[objective];
+                distances[last.front()] = std::numeric_limits<double>::infinity();
+                distances[last.back()] = std::numeric_limits<double>::infinity();
+                for (int i = 1; i + 1 < last.size() && range > 0; i++) {
+                    distances[last[i]] += (fitness(last[i + 1])[objective] - fitness(last[i - 1])[objective]) / range;
+                }
+            }
+            int remaining = count - selected.size();
+            std::nth_element(last.begin(), last.begin() + remaining - 1, last.end(), [&](int a, int b) {
+                return distances[a] > distances[b] || (distances[a] == distances[b] && a < b);
+            });
+            selected.insert(selected.end(), last.begin(), last.begin() + remaining);
+        }
+        return selected;
+    };
+}
+
+/*
+    NSGA-II Selection: Like select_nsga2_indices, evaluating the offspring and returning the selected genes
+    Arguments:
+        - mu:       number of individuals to select
+        - evaluate: function taking a vector of genes and returning a vector of fitness vectors
+*/
+
+template<typename T, typename L, typename G = std::mt19937>
+std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)> select_nsga2(int mu, std::function<std::vector<L>(const std::vector<T>&)> evaluate) {
+    return [evaluate, select = select_nsga2_indices<L, G>(mu)](const std::vector<T>& parents, const std::vector<L>& fitnesses_parents, const std::vector<int>& ranks_parents, const std::vector<T>& offspring, G& generator) mutable -> std::vector<T> {
+        return gather_survivors(select(fitnesses_parents, ranks_parents, evaluate(offspring), generator), parents, offspring);
+    };
+}
+
+/*
+    Hypervolume Selection: Selects mu individuals from the combined population of parents and offspring front by front (pareto ranking),
+    the front which does not fit completely is reduced by repeatedly removing the individual with the smallest hypervolume contribution.
+    With two objectives only the contributions of the two neighbours of a removed individual change, so reducing the front takes O(N log N);
+    with more objectives only the contributions of individuals whose jointly dominated region with the removed one is not dominated by a
+    third individual are computed again
+    Arguments:
+        - mu:        number of individuals to select
+        - reference: reference point of the hypervolume, has to be worse than all relevant fitness vectors in every objective
+*/
+
+template<typename G = std::mt19937>
+std::function<std::vector<int>(const std::vector<std::vector<double>>&, const std::vector<int>&, const std::vector<std::vector<double>>&, G&)> select_hypervolume_indices(int mu, std::vector<double> reference) {
+    using L = std::vector<double>;
+    return [mu, reference, sorter = ParetoSorter<L>(), selected = std::vector<int>(), last = std::vector<int>(), previous = std::vector<int>(),
+        next = std::vector<int>(), contributions = std::vector<double>(), points = std::vector<L>(), others = std::vector<L>(), removed = std::vector<bool>()](
+        const std::vector<L>& fitnesses_parents, const std::vector<int>& ranks_parents, const std::vector<L>& fitnesses_children, G& generator
+    ) mutable -> std::vector<int> {
+        auto fitness = [&](int index) -> const L& {
+            return index < fitnesses_parents.size() ? fitnesses_parents[index] : fitnesses_children[index - fitnesses_parents.size()];
+        };
+        sorter.sort(fitnesses_parents, fitnesses_children);
+        int count = std::min(mu, (int) (fitnesses_parents.size() + fitnesses_children.size()));
+        selected.clear();
+        int f = 0;
+        for (; selected.size() < count && selected.size() + sorter.get_front(f).size() <= count; f++) {
+            selected.insert(selected.end(), sorter.get_front(f).begin(), sorter.get_front(f).end());
+        }
+        if (selected.size() < count && reference.size() == 2) {
+            last.assign(sorter.get_front(f).begin(), sorter.get_front(f).end());
+            // points not above the reference contribute nothing and are removed first, the others are linked in descending order of the
+            // first objective (ascending in the second), duplicates are adjacent and get a contribution of 0 from their neighbour
+            auto above = [&](int index) -> bool {
+                return fitness(index)[0] > reference[0] && fitness(index)[1] > reference[1];
+            };
+            auto outside = std::stable_partition(last.begin(), last.end(), above);
+            int removals = last.size() - (count - selected.size());
+            int outside_removals = std::min(removals, (int) (last.end() - outside));
+            last.erase(last.end() - outside_removals, last.end());
+            removals -= outside_removals;
+            int inside_n = outside - last.begin();
+            std::sort(last.begin(), last.begin() + inside_n, [&](int a, int b) {
+                return fitness(a) > fitness(b);
+            });
+            previous.resize(inside_n);
+            next.resize(inside_n);
+            contributions.resize(inside_n);
+            for (int k = 0; k < inside_n; k++) {
+                previous[k] = k - 1;
+                next[k] = k + 1 < inside_n ? k + 1 : -1;
+            }
+            auto contribution = [&](int k) -> double {
+                double x_next = next[k] >= 0 ? fitness(last[next[k]])[0] : reference[0];
+                double y_previous = previous[k] >= 0 ? fitness(last[previous[k]])[1] : reference[1];
+                return (fitness(last[k])[0] - x_next) * (fitness(last[k])[1] - y_previous);
+            };
+            std::set<std::pair<double, int>> smallest;
+            for (int k = 0; k < inside_n; k++) {
+                contributions[k] = contribution(k);
+                smallest.emplace(contributions[k], k);
+            }
+            for (; removals > 0; removals--) {
+                int k = smallest.begin()->second;
+                smallest.erase(smallest.begin());
+                if (previous[k] >= 0) {
+                    next[previous[k]] = next[k];
+                }
+                if (next[k] >= 0) {
+                    previous[next[k]] = previous[k];
+                }
+                for (int neighbour : {previous[k], next[k]}) {
+                    if (neighbour >= 0) {
+                        smallest.erase({contributions[neighbour], neighbour});
+                        contributions[neighbour] = contribution(neighbour);
+                        smallest.emplace(contributions[neighbour], neighbour);
+                    }
+                }
+                last[k] = -1;
+            }
+            for (int index : last) {
+                if (index >= 0) {
+                    selected.emplace_back(index);
+                }
+            }
+        } else if (selected.size() < count) {
+            // with three and more objectives removing q only changes the contribution of a point p if the region dominated by both (bounded
+            // by their componentwise minimum) is not dominated by a third remaining point, only those contributions are computed again
+            last.assign(sorter.get_front(f).begin(), sorter.get_front(f).end());
+            points.resize(last.size());
+            for (int i = 0; i < last.size(); i++) {
+                points[i] = fitness(last[i]);
+            }
+            // points not above the reference have no contribution and are removed first
+            contributions = hypervolume_contributions(points, reference);
+            removed.assign(last.size(), false);
+            for (int k = 0; k < last.size(); k++) {
+                for (int i = 0; i < reference.size(); i++) {
+                    contributions[k] = points[k][i] > reference[i] ? contributions[k] : -1;
+                }
+            }
+            auto covered = [&](int p, int q) -> bool {
+                for (int r = 0; r < last.size(); r++) {
+                    if (removed[r] || r == p || r == q) {
+                        continue;
+                    }
+                    bool dominates = true;
+                    for (int i = 0; i < reference.size() && dominates; i++) {
+                        dominates = points[r][i] >= std::min(points[p][i], points[q][i]);
+                    }
+                    if (dominates) {
+                        return true;
+                    }
+                }
+                return false;
+            };
+            for (int remaining = last.size(); selected.size() + remaining > count; remaining--) {
+                int q = -1;
+                for (int k = 0; k < last.size(); k++) {
+                    if (!removed[k] && (q < 0 || contributions[k] < contributions[q])) {
+                        q = k;
+                    }
+                }
+                removed[q] = true;
+                for (int p = 0; p < last.size() && contributions[q] >= 0; p++) {
+                    if (removed[p] || contributions[p] < 0 || covered(p, q)) {
+                        continue;
+                    }
+                    // exclusive volume of p with respect to all remaining points, p is moved to the front of the list
+                    others.resize(1);
+                    others[0] = points[p];
+                    for (int r = 0; r < last.size(); r++) {
+                        if (!removed[r] && r != p) {
+                            others.emplace_back(points[r]);
+                        }
+                    }
+                    contributions[p] = hypervolume_exclusive(others, 0, reference);
+                }
+            }
+            for (int k = 0; k < last.size(); k++) {
+                if (!removed[k]) {
+                    selected.emplace_back(last[k]);
+                }
+            }
+        }
+        return selected;
+    };
+}
+
+/*
+    Hypervolume Selection: Like select_hypervolume_indices, evaluating the offspring and returning the selected genes
+    Arguments:
+        - mu:        number of individuals to select
+        - evaluate:  function taking a vector of genes and returning a vector of fitness vectors
+        - reference: reference point of the hypervolume, has to be worse than all relevant fitness vectors in every objective
+*/
+
+template<typename T, typename G = std::mt19937>
+std::function<std::vector<T>(const std::vector<T>&, const std::vector<std::vector<double>>&, const std::vector<int>&, const std::vector<T>&, G&)> select_hypervolume(int mu, std::function<std::vector<std::vector<double>>(const std::vector<T>&)> evaluate, std::vector<double> reference) {
+    using L = std::vector<double>;
+    return [evaluate, select = select_hypervolume_indices<G>(mu, reference)](const std::vector<T>& parents, const std::vector<L>& fitnesses_parents, const std::vector<int>& ranks_parents, const std::vector<T>& offspring, G& generator) mutable -> std::vector<T> {
+        return gather_survivors(select(fitnesses_parents, ranks_parents, evaluate(offspring), generator), parents, offspring);
     };
-};
\ No newline at end of file
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+// Lazily evaluated sequence of values of type T produced by a coroutine using co_yield, consumable once with a range based for loop
+template<typename T>
+class Generator{
+
+public:
+
+    struct promise_type{
+        T* current = nullptr;
+        std::exception_ptr exception;
+
+        Generator get_return_object() { return Generator(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(T& value) noexcept { current = std::addressof(value); return {}; }
+        std::suspend_always yield_value(T&& value) noexcept { current = std::addressof(value); return {}; }
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    class iterator{
+    private:
+        std::coroutine_handle<promise_type> handle;
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+
+        explicit iterator(std::coroutine_handle<promise_type> handle = nullptr) : handle(handle) {}
+        T& operator*() const { return *handle.promise().current; }
+        iterator& operator++();
+        bool operator==(std::default_sentinel_t) const { return !handle || handle.done(); }
+    };
+
+private:
+
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Generator(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+public:
+
+    Generator(Generator&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    ~Generator();
+
+    iterator begin(); //resumes the coroutine up to the first co_yield
+    std::default_sentinel_t end() { return {}; }
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+Generator<T>::~Generator() {
+    if (handle) {
+        handle.destroy();
+    }
+}
+
+template<typename T>
+typename Generator<T>::iterator Generator<T>::begin() {
+    handle.resume();
+    if (handle.promise().exception) {
+        std::rethrow_exception(handle.promise().exception);
+    }
+    return iterator(handle);
+}
+
+template<typename T>
+typename Generator<T>::iterator& Generator<T>::iterator::operator++() {
+    handle.resume();
+    if (handle.promise().exception) {
+        std::rethrow_exception(handle.promise().exception);
+    }
+    return *this;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+#include <system_error>
+#include <cerrno>
+#include <assert.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+// Storage for size genes of gene_length chromosomes of type E, kept as fixed-size records in a memory-mapped file
+template<typename E>
+class MappedGenes{
+
+    static_assert(std::is_trivially_copyable_v<E>, "chromosomes of mapped genes must be trivially copyable");
+
+private:
+
+    std::string path;
+    int gene_length;
+    size_t size;
+    size_t bytes;
+    int file;
+    E* data;
+
+    void unmap();
+
+public:
+
+    // Creates (or truncates) the file at path and maps it with room for size genes of length gene_length, the file is removed on destruction
+    MappedGenes(const std::string& path, size_t size, int gene_length);
+    MappedGenes(MappedGenes&& other) noexcept;
+    MappedGenes(const MappedGenes&) = delete;
+    MappedGenes& operator=(const MappedGenes&) = delete;
+    ~MappedGenes();
+
+    std::vector<std::vector<E>> read(size_t begin, size_t end) const; //copies the genes [begin, end) into memory
+    void write(size_t begin, const std::vector<std::vector<E>>& genes); //stores genes starting at position begin
+    void advise_sequential(); //hints the kernel that the records are swept in order and should be read ahead
+    void prefetch(size_t begin, size_t end); //hints the kernel that the genes [begin, end) will be needed soon
+    void release(size_t begin, size_t end); //drops the genes [begin, end) from the resident memory of the process, the file keeps them
+    size_t get_size() const;
+    int get_gene_length() const;
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+template<typename E>
+MappedGenes<E>::MappedGenes(const std::string& path, size_t size, int gene_length) : path(path), gene_length(gene_length), size(size), bytes(size * gene_length * sizeof(E)), file(-1), data(nullptr) {
+    assert(size > 0 && gene_length > 0);
+    file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(file < 0){
+        throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    if(ftruncate(file, bytes) != 0){
+        int error = errno;
+        close(file);
+        throw std::system_error(error, std::generic_category(), "ftruncate " + path);
+    }
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if(mapping == MAP_FAILED){
+        int error = errno;
+        close(file);
+        throw std::system_error(error, std::generic_category(), "mmap " + path);
+    }
+    data = static_cast<E*>(mapping);
+    advise_sequential();
+}
+
+template<typename E>
+MappedGenes<E>::MappedGenes(MappedGenes&& other) noexcept : path(std::move(other.path)), gene_length(other.gene_length), size(other.size), bytes(other.bytes), file(other.file), data(other.data) {
+    other.file = -1;
+    other.data = nullptr;
+}
+
+template<typename E>
+MappedGenes<E>::~MappedGenes(){
+    unmap();
+}
+
+template<typename E>
+void MappedGenes<E>::unmap(){
+    if(data != nullptr){
+        munmap(data, bytes);
+        data = nullptr;
+    }
+    if(file >= 0){
+        close(file);
+        unlink(path.c_str());
+        file = -1;
+    }
+}
+
+template<typename E>
+std::vector<std::vector<E>> MappedGenes<E>::read(size_t begin, size_t end) const {
+    assert(begin <= end && end <= size);
+    std::vector<std::vector<E>> genes(end - begin);
+    for(size_t i = begin; i < end; i++){
+        const E* record = data + i * gene_length;
+        genes[i - begin].assign(record, record + gene_length);
+    }
+    return genes;
+}
+
+template<typename E>
+void MappedGenes<E>::write(size_t begin, const std::vector<std::vector<E>>& genes){
+    assert(begin + genes.size() <= size);
+    for(size_t i = 0; i < genes.size(); i++){
+        assert(genes[i].size() == gene_length);
+        std::copy(genes[i].begin(), genes[i].end(), data + (begin + i) * gene_length);
+    }
+}
+
+template<typename E>
+void MappedGenes<E>::advise_sequential(){
+    madvise(data, bytes, MADV_SEQUENTIAL);
+}
+
+// madvise needs page aligned addresses, so the ranges are widened to whole pages
+template<typename E>
+void MappedGenes<E>::prefetch(size_t begin, size_t end){
+    const size_t page = sysconf(_SC_PAGESIZE);
+    size_t first = (begin * gene_length * sizeof(E)) / page * page;
+    size_t last = std::min(bytes, end * gene_length * sizeof(E));
+    if(first < last){
+        madvise(reinterpret_cast<char*>(data) + first, last - first, MADV_WILLNEED);
+    }
+}
+
+// only whole pages inside the range are released, so records of neighbouring blocks sharing a page stay resident
+template<typename E>
+void MappedGenes<E>::release(size_t begin, size_t end){
+    const size_t page = sysconf(_SC_PAGESIZE);
+    size_t first = (begin * gene_length * sizeof(E) + page - 1) / page * page;
+    size_t last = (end * gene_length * sizeof(E)) / page * page;
+    if(first < last){
+        madvise(reinterpret_cast<char*>(data) + first, last - first, MADV_DONTNEED);
+    }
+}
+
+template<typename E>
+size_t MappedGenes<E>::get_size() const {
+    return size;
+}
+
+template<typename E>
+int MappedGenes<E>::get_gene_length() const {
+    return gene_length;
+}
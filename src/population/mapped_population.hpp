@@ -0,0 +1,196 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <string>
+#include <random>
+#include <assert.h>
+
+#include "mapped_genes.hpp"
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+/*
+    Class for a population too large for the main memory: genes with gene_length chromosomes of type E are kept in memory-mapped files and
+    every generation streams through them block by block, while the fitness values of type L stay resident. The operators are the same as
+    for Population<std::vector<E>, L, G> and are applied to one block of block_size genes at a time, so parent and survivor selection only
+    see the genes of the current block (the blocks act like islands of one generation).
+*/
+template<typename E, typename L, typename G = std::mt19937>
+class MappedPopulation{
+
+    using T = std::vector<E>;
+
+private:
+
+    MappedGenes<E> buffers[2];
+    int current;
+    int block_size;
+    std::vector<L> fitnesses;
+    G generator;
+
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate;
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)> selectParents;
+    std::function<std::vector<T>(const std::vector<T>&, G&)> mutate;
+    std::function<std::vector<T>(const std::vector<T>&, G&)> recombine;
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)> selectSurvivors;
+    std::function<std::vector<int>(const std::vector<L>&)> rank;
+    std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, const std::vector<L>&, G&)> selectSurvivorIndices;
+
+public:
+
+    /*
+        Constructor for a population of size genes stored in the files path + ".0" and path + ".1", initialized block by block,
+        where initialize has to return block_size genes of length gene_length per call
+    */
+    MappedPopulation(
+        int seed,
+        const std::string& path,
+        size_t size,
+        int gene_length,
+        int block_size,
+        const std::function<std::vector<T>(G&)>& initialize,
+        const std::function<std::vector<L>(const std::vector<T>&)>& evaluate,
+        const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)>& selectParents,
+        const std::function<std::vector<T>(const std::vector<T>&, G&)>& mutate = nullptr,
+        const std::function<std::vector<T>(const std::vector<T>&, G&)>& recombine = nullptr,
+        const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)>& selectSurvivors = nullptr,
+        const std::function<std::vector<int>(const std::vector<L>&)>& rank = nullptr
+    );
+
+    void execute(); //executes one iteration of the evolutionary algorithm, sweeping once over all blocks
+    void execute_multiple(int generations); //executes 'generations' iterations of the evolutionary algorithm
+    std::vector<T> get_bests(bool keep_duplicats); //returns the best genes in the population (by fitness value, or rank 1 within their block)
+    std::vector<T> get_genes(size_t begin, size_t end); //returns the genes [begin, end) of the population
+    const std::vector<L>& get_fitnesses(); //returns the resident fitness values of all genes
+    size_t size();
+
+    void set_selectSurvivorIndices(const std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, const std::vector<L>&, G&)>& selectSurvivorIndices); //replaces selectSurvivors, so the survivors keep the fitness values of the selection instead of being evaluated again
+
+};
+
+// Class Implementation ---------------------------------------------------------------------------------------------------------------------
+
+template<typename E, typename L, typename G>
+MappedPopulation<E, L, G>::MappedPopulation(
+    int seed,
+    const std::string& path,
+    size_t size,
+    int gene_length,
+    int block_size,
+    const std::function<std::vector<T>(G&)>& initialize,
+    const std::function<std::vector<L>(const std::vector<T>&)>& evaluate,
+    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)>& selectParents,
+    const std::function<std::vector<T>(const std::vector<T>&, G&)>& mutate,
+    const std::function<std::vector<T>(const std::vector<T>&, G&)>& recombine,
+    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)>& selectSurvivors,
+    const std::function<std::vector<int>(const std::vector<L>&)>& rank
+) : buffers{MappedGenes<E>(path + ".0", size, gene_length), MappedGenes<E>(path + ".1", size, gene_length)}, current(0), block_size(block_size), fitnesses(size), generator(seed),
+    evaluate(evaluate), selectParents(selectParents), mutate(mutate), recombine(recombine), selectSurvivors(selectSurvivors), rank(rank) {
+    assert((evaluate != nullptr && selectParents != nullptr && block_size > 0));
+    for(size_t begin = 0; begin < size; begin += block_size){
+        size_t end = std::min(size, begin + block_size);
+        std::vector<T> block = initialize(generator);
+        assert(block.size() >= end - begin);
+        block.resize(end - begin);
+        std::vector<L> block_fitnesses = evaluate(block);
+        std::copy(block_fitnesses.begin(), block_fitnesses.end(), fitnesses.begin() + begin);
+        buffers[current].write(begin, block);
+        buffers[current].release(begin, end);
+    }
+}
+
+template<typename E, typename L, typename G>
+void MappedPopulation<E, L, G>::execute(){
+    MappedGenes<E>& source = buffers[current];
+    MappedGenes<E>& target = buffers[1 - current];
+    for(size_t begin = 0; begin < size(); begin += block_size){
+        size_t end = std::min(size(), begin + block_size);
+        source.prefetch(end, std::min(size(), end + block_size));
+        std::vector<T> genes = source.read(begin, end);
+        std::vector<L> block_fitnesses(fitnesses.begin() + begin, fitnesses.begin() + end);
+        std::vector<int> ranks = (rank == nullptr) ? std::vector<int>() : rank(block_fitnesses);
+        std::vector<T> parents = selectParents(genes, block_fitnesses, ranks, generator);
+        std::vector<T> children = (recombine == nullptr) ? parents : recombine(parents, generator);
+        children = (mutate == nullptr) ? children : mutate(children, generator);
+        if(selectSurvivorIndices != nullptr){
+            // only the children are evaluated, the survivors keep the fitness values passed to the selection
+            std::vector<L> children_fitnesses = evaluate(children);
+            std::vector<int> survivors = selectSurvivorIndices(block_fitnesses, ranks, children_fitnesses, generator);
+            assert(survivors.size() == end - begin);
+            std::vector<T> next(survivors.size());
+            for(int i = 0; i < survivors.size(); i++){
+                int survivor = survivors[i];
+                next[i] = survivor < genes.size() ? genes[survivor] : children[survivor - genes.size()];
+                fitnesses[begin + i] = survivor < genes.size() ? block_fitnesses[survivor] : children_fitnesses[survivor - genes.size()];
+            }
+            genes = std::move(next);
+        }else{
+            genes = (selectSurvivors == nullptr) ? children : selectSurvivors(genes, block_fitnesses, ranks, children, generator);
+            assert(genes.size() == end - begin);
+            block_fitnesses = evaluate(genes);
+            std::copy(block_fitnesses.begin(), block_fitnesses.end(), fitnesses.begin() + begin);
+        }
+        target.write(begin, genes);
+        source.release(begin, end);
+        target.release(begin, end);
+    }
+    current = 1 - current;
+}
+
+template<typename E, typename L, typename G>
+void MappedPopulation<E, L, G>::execute_multiple(int generations){
+    for(int i = 0; i < generations; i++){
+        execute();
+    }
+}
+
+template<typename E, typename L, typename G>
+std::vector<std::vector<E>> MappedPopulation<E, L, G>::get_bests(bool keep_duplicats){
+    std::vector<T> bests;
+    if(rank != nullptr){
+        for(size_t begin = 0; begin < size(); begin += block_size){
+            size_t end = std::min(size(), begin + block_size);
+            std::vector<int> ranks = rank(std::vector<L>(fitnesses.begin() + begin, fitnesses.begin() + end));
+            for(size_t i = begin; i < end; i++){
+                if(ranks[i - begin] == 1){
+                    bests.emplace_back(buffers[current].read(i, i + 1)[0]);
+                }
+            }
+        }
+    }else{
+        auto max_it = std::max_element(fitnesses.begin(), fitnesses.end());
+        for(size_t i = 0; i < size(); i++){
+            if(fitnesses[i] == *max_it){
+                bests.emplace_back(buffers[current].read(i, i + 1)[0]);
+            }
+        }
+    }
+    std::sort(bests.begin(), bests.end());
+    if(keep_duplicats){
+        return bests;
+    }
+    bests.erase(std::unique(bests.begin(), bests.end()), bests.end());
+    return bests;
+}
+
+template<typename E, typename L, typename G>
+std::vector<std::vector<E>> MappedPopulation<E, L, G>::get_genes(size_t begin, size_t end){
+    return buffers[current].read(begin, end);
+}
+
+template<typename E, typename L, typename G>
+const std::vector<L>& MappedPopulation<E, L, G>::get_fitnesses(){
+    return fitnesses;
+}
+
+template<typename E, typename L, typename G>
+size_t MappedPopulation<E, L, G>::size(){
+    return fitnesses.size();
+}
+
+template<typename E, typename L, typename G>
+void MappedPopulation<E, L, G>::set_selectSurvivorIndices(const std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, const std::vector<L>&, G&)>& selectSurvivorIndices){
+    this->selectSurvivorIndices = selectSurvivorIndices;
+}
@@ -8,34 +8,49 @@
 #include <string>
 #include <random>
 #include <cctype>
-#include <random>
 #include <assert.h>
+#include <iterator>
+#include <numeric>
+#include <utility>
+#include <memory>
+
+#include "generator.hpp"
+#include "streaming_selection.hpp"
 
 // Class Outline ----------------------------------------------------------------------------------------------------------------------------
 
-// Class for a population of genes of type T, with fitness values of type L
-template<typename T, typename L>
+// Class for a population of genes of type T, with fitness values of type L, using a random engine of type G
+template<typename T, typename L, typename G = std::mt19937>
 class Population{
 
 private:
 
     std::vector<T> genes;
-    std::mt19937 generator;
+    std::vector<L> fitnesses; // fitness values of the genes, only valid if fitnesses_current is set (after a generation selecting survivors by index or a streaming generation)
+    bool fitnesses_current;
+    G generator;
 
     // Function taking a vector of genes of type T and returning its fitness value vector of type L
-    const std::function<std::vector<L>(const std::vector<T>&)>& evaluate;
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate;
     // Function taking a vector of genes of type T and returning a vector of parents of type T
-    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)>& selectParents;
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)> selectParents;
     // Function taking a vector of genes of type T and returning a vector of mutated genes of type T
-    const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& mutate;
+    std::function<std::vector<T>(const std::vector<T>&, G&)> mutate;
     // Function taking a vector of genes of type T and returning a vector of recombined genes of type T
-    const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& recombine;
+    std::function<std::vector<T>(const std::vector<T>&, G&)> recombine;
     // Function taking two vectors of genes of type T (parents and children) and returning a selected vector of genes of type T
-    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)>& selectSurvivors;
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)> selectSurvivors;
     // Function taking a vector of fitness values of type L and returning a vector of ranks of type int
-    const std::function<std::vector<int>(const std::vector<L>&)>& rank;
+    std::function<std::vector<int>(const std::vector<L>&)> rank;
+    // Function taking fitness values, ranks and a number n and returning the indices of n parents, used by the streaming execution
+    std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, int, G&)> selectParentIndices;
+    // Function taking the fitness values and ranks of the parents and the fitness values of the children and returning the indices of the survivors, replaces selectSurvivors
+    std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, const std::vector<L>&, G&)> selectSurvivorIndices;
+    // Survivor selection deciding batch by batch, used by the streaming execution instead of selectSurvivors
+    std::shared_ptr<StreamingSurvivorSelection<L>> selectSurvivorsStreaming;
 
     void check_types();
+    Generator<std::pair<std::vector<T>, std::vector<L>>> offspring(const std::vector<int>& ranks, int batch_size); //lazily selects, recombines, mutates and evaluates the offspring batch by batch
 
 public:
 
@@ -44,98 +59,223 @@ public:
         int seed,
         const std::vector<T>& initial_genes,
         const std::function<std::vector<L>(const std::vector<T>&)>& evaluate,
-        const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)>& selectParents,
-        const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& mutate = nullptr,
-        const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& recombine = nullptr,
-        const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)>& selectSurvivors = nullptr,
+        const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)>& selectParents,
+        const std::function<std::vector<T>(const std::vector<T>&, G&)>& mutate = nullptr,
+        const std::function<std::vector<T>(const std::vector<T>&, G&)>& recombine = nullptr,
+        const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)>& selectSurvivors = nullptr,
         const std::function<std::vector<int>(const std::vector<L>&)>& rank = nullptr
     );
 
     // Constructor for population of size size will with genes generated by function initialize
     Population(
         int seed,
-        const std::function<std::vector<T>(std::mt19937&)>& initialize,
+        const std::function<std::vector<T>(G&)>& initialize,
         const std::function<std::vector<L>(const std::vector<T>&)>& evaluate,
-        const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)>& selectParents,
-        const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& mutate = nullptr,
-        const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& recombine = nullptr,
-        const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)>& selectSurvivors = nullptr,
+        const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)>& selectParents,
+        const std::function<std::vector<T>(const std::vector<T>&, G&)>& mutate = nullptr,
+        const std::function<std::vector<T>(const std::vector<T>&, G&)>& recombine = nullptr,
+        const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)>& selectSurvivors = nullptr,
         const std::function<std::vector<int>(const std::vector<L>&)>& rank = nullptr
     );
 
     void execute(); //executes one iteration of the evolutionary algorithm
     void execute_multiple(int generations); //executes 'generations' iterations of the evolutionary algorithm
+    void execute_streaming(int batch_size); //executes one iteration, passing the offspring through selection, recombination, mutation, evaluation and the streaming survivor selection in batches of batch_size
+    void execute_multiple_streaming(int generations, int batch_size); //executes 'generations' streaming iterations of the evolutionary algorithm
     std::vector<T> get_bests(bool keep_duplicats); //returns the best genes in the population
     std::vector<T> get_genes(); //returns the current genes in the population
     void set_genes(std::vector<T> genes); //sets the genes of the population
     std::string to_string(); //returns a string representation of the population
 
     void set_evaluate(const std::function<std::vector<L>(const std::vector<T>&)>& evaluate);
-    void set_selectParents(const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)>& selectParents);
-    void set_mutate(const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& mutate);
-    void set_recombine(const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& recombine);
-    void set_selectSurvivors(const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)>& selectSurvivors);
+    void set_selectParents(const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)>& selectParents);
+    void set_mutate(const std::function<std::vector<T>(const std::vector<T>&, G&)>& mutate);
+    void set_recombine(const std::function<std::vector<T>(const std::vector<T>&, G&)>& recombine);
+    void set_selectSurvivors(const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)>& selectSurvivors);
     void set_rank(const std::function<std::vector<int>(const std::vector<L>&)>& rank);
+    void set_selectParentIndices(const std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, int, G&)>& selectParentIndices);
+    void set_selectSurvivorIndices(const std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, const std::vector<L>&, G&)>& selectSurvivorIndices);
+    void set_selectSurvivorsStreaming(const std::shared_ptr<StreamingSurvivorSelection<L>>& selectSurvivorsStreaming);
 
 };
 
 // Class Implementation ---------------------------------------------------------------------------------------------------------------------
 
-template<typename T, typename L>
-Population<T, L>::Population(
+template<typename T, typename L, typename G>
+Population<T, L, G>::Population(
     int seed,
     const std::vector<T>& initial_genes,
     const std::function<std::vector<L>(const std::vector<T>&)>& evaluate,
-    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)>& selectParents,
-    const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& mutate,
-    const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& recombine,
-    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)>& selectSurvivors,
+    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)>& selectParents,
+    const std::function<std::vector<T>(const std::vector<T>&, G&)>& mutate,
+    const std::function<std::vector<T>(const std::vector<T>&, G&)>& recombine,
+    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)>& selectSurvivors,
     const std::function<std::vector<int>(const std::vector<L>&)>& rank
-) : generator(seed), genes(initial_genes), evaluate(evaluate), selectParents(selectParents), mutate(mutate), recombine(recombine), selectSurvivors(selectSurvivors), rank(rank) {
+) : genes(initial_genes), fitnesses_current(false), generator(seed), evaluate(evaluate), selectParents(selectParents), mutate(mutate), recombine(recombine), selectSurvivors(selectSurvivors), rank(rank) {
     check_types();
 }
 
-template<typename T, typename L>
-Population<T, L>::Population(
+template<typename T, typename L, typename G>
+Population<T, L, G>::Population(
     int seed,
-    const std::function<std::vector<T>(std::mt19937&)>& initialize,
+    const std::function<std::vector<T>(G&)>& initialize,
     const std::function<std::vector<L>(const std::vector<T>&)>& evaluate,
-    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)>& selectParents,
-    const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& mutate,
-    const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& recombine,
-    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)>& selectSurvivors,
+    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)>& selectParents,
+    const std::function<std::vector<T>(const std::vector<T>&, G&)>& mutate,
+    const std::function<std::vector<T>(const std::vector<T>&, G&)>& recombine,
+    const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)>& selectSurvivors,
     const std::function<std::vector<int>(const std::vector<L>&)>& rank
-) : generator(seed), evaluate(evaluate), selectParents(selectParents), mutate(mutate), recombine(recombine), selectSurvivors(selectSurvivors), rank(rank) {
+) : fitnesses_current(false), generator(seed), evaluate(evaluate), selectParents(selectParents), mutate(mutate), recombine(recombine), selectSurvivors(selectSurvivors), rank(rank) {
     check_types();
     genes = initialize(generator);
 }
 
-template<typename T, typename L>
-void Population<T, L>::check_types() {
+template<typename T, typename L, typename G>
+void Population<T, L, G>::check_types() {
     assert((evaluate != nullptr && selectParents != nullptr));
 }
 
-template<typename T, typename L>
-void Population<T, L>::execute() {
-    std::vector<L> fitnesses = evaluate(genes);
+template<typename T, typename L, typename G>
+void Population<T, L, G>::execute() {
+    if(!fitnesses_current){
+        fitnesses = evaluate(genes);
+    }
     std::vector<int> ranks = (rank == nullptr) ? std::vector<int>() : rank(fitnesses);
     std::vector<T> parents = selectParents(genes, fitnesses, ranks, generator);
     std::vector<T> children = (recombine == nullptr) ? parents : recombine(parents, generator);
     children = (mutate == nullptr) ? children : mutate(children, generator);
+    if(selectSurvivorIndices != nullptr){
+        // only the children are evaluated, the fitness values of the survivors are kept for the next generation
+        std::vector<L> children_fitnesses = evaluate(children);
+        std::vector<int> survivors = selectSurvivorIndices(fitnesses, ranks, children_fitnesses, generator);
+        std::vector<T> next(survivors.size());
+        std::vector<L> next_fitnesses(survivors.size());
+        for(int i = 0; i < survivors.size(); i++){
+            int survivor = survivors[i];
+            next[i] = survivor < genes.size() ? genes[survivor] : children[survivor - genes.size()];
+            next_fitnesses[i] = survivor < genes.size() ? fitnesses[survivor] : children_fitnesses[survivor - genes.size()];
+        }
+        genes = std::move(next);
+        fitnesses = std::move(next_fitnesses);
+        fitnesses_current = true;
+        return;
+    }
     genes = (selectSurvivors == nullptr) ? children : selectSurvivors(genes, fitnesses, ranks, children, generator);
+    fitnesses_current = false;
 }
 
-template<typename T, typename L>
-void Population<T, L>::execute_multiple(int generations){
+template<typename T, typename L, typename G>
+void Population<T, L, G>::execute_multiple(int generations){
     for(int i = 0; i < generations; i++){
         execute();
     }
 }
 
-template<typename T, typename L>
-std::vector<T> Population<T, L>::get_bests(bool keep_duplicats){
+template<typename T, typename L, typename G>
+Generator<std::pair<std::vector<T>, std::vector<L>>> Population<T, L, G>::offspring(const std::vector<int>& ranks, int batch_size){
+    std::vector<T> parents;
+    if(selectParentIndices == nullptr){
+        parents = selectParents(genes, fitnesses, ranks, generator);
+    }
+    for(int begin = 0; begin < genes.size(); begin += batch_size){
+        int end = std::min((int) genes.size(), begin + batch_size);
+        std::vector<T> batch;
+        if(selectParentIndices == nullptr){
+            batch.assign(std::make_move_iterator(parents.begin() + begin), std::make_move_iterator(parents.begin() + end));
+        }else{
+            for(int index : selectParentIndices(fitnesses, ranks, end - begin, generator)){
+                batch.emplace_back(genes[index]);
+            }
+        }
+        batch = (recombine == nullptr) ? std::move(batch) : recombine(batch, generator);
+        batch = (mutate == nullptr) ? std::move(batch) : mutate(batch, generator);
+        std::vector<L> batch_fitnesses = evaluate(batch);
+        co_yield std::make_pair(std::move(batch), std::move(batch_fitnesses));
+    }
+}
+
+template<typename T, typename L, typename G>
+void Population<T, L, G>::execute_streaming(int batch_size){
+    assert(batch_size > 0);
+    // the survivor selection by genes or indices needs all offspring at once, the streaming execution needs a streaming selection instead
+    assert((selectSurvivorsStreaming != nullptr || (selectSurvivors == nullptr && selectSurvivorIndices == nullptr)));
+    batch_size += batch_size % 2; // recombination works on pairs, so a batch must not split one
+    if(!fitnesses_current){
+        fitnesses = evaluate(genes);
+    }
+    std::vector<int> ranks = (rank == nullptr) ? std::vector<int>() : rank(fitnesses);
+    // slot i of the next generation holds the current gene sources[i] until an offspring takes it over (sources[i] is then -1)
+    std::vector<int> sources;
+    if(selectSurvivorsStreaming != nullptr){
+        sources = selectSurvivorsStreaming->begin(fitnesses, ranks);
+    }else{
+        sources.resize(genes.size());
+        std::iota(sources.begin(), sources.end(), 0);
+    }
+    std::vector<T> next(sources.size());
+    std::vector<L> next_fitnesses(sources.size());
+    std::vector<bool> filled(sources.size(), false);
+    for(int slot = 0; slot < sources.size(); slot++){
+        if(sources[slot] >= 0){
+            next_fitnesses[slot] = fitnesses[sources[slot]];
+            filled[slot] = true;
+        }
+    }
+    int slot_n = 0;
+    for(std::pair<std::vector<T>, std::vector<L>>& batch : offspring(ranks, batch_size)){
+        std::vector<int> slots;
+        if(selectSurvivorsStreaming != nullptr){
+            slots = selectSurvivorsStreaming->offer(batch.second);
+        }else{
+            // without survivor selection the offspring replace the current genes in order
+            for(int i = 0; i < batch.first.size(); i++){
+                slots.emplace_back(slot_n < sources.size() ? slot_n++ : -1);
+            }
+        }
+        for(int i = 0; i < batch.first.size(); i++){
+            int slot = slots[i];
+            if(slot >= 0){
+                next[slot] = std::move(batch.first[i]);
+                next_fitnesses[slot] = std::move(batch.second[i]);
+                sources[slot] = -1;
+                filled[slot] = true;
+            }
+        }
+    }
+    for(int slot = 0; slot < sources.size(); slot++){
+        if(sources[slot] >= 0){
+            next[slot] = std::move(genes[sources[slot]]);
+        }
+    }
+    // slots which neither a current gene nor an offspring filled are dropped
+    int size = 0;
+    for(int slot = 0; slot < sources.size(); slot++){
+        if(filled[slot]){
+            if(slot != size){
+                next[size] = std::move(next[slot]);
+                next_fitnesses[size] = std::move(next_fitnesses[slot]);
+            }
+            size++;
+        }
+    }
+    next.resize(size);
+    next_fitnesses.resize(size);
+    genes = std::move(next);
+    fitnesses = std::move(next_fitnesses);
+    fitnesses_current = true;
+}
+
+template<typename T, typename L, typename G>
+void Population<T, L, G>::execute_multiple_streaming(int generations, int batch_size){
+    for(int i = 0; i < generations; i++){
+        execute_streaming(batch_size);
+    }
+}
+
+template<typename T, typename L, typename G>
+std::vector<T> Population<T, L, G>::get_bests(bool keep_duplicats){
     std::vector<T> bests;
-    std::vector<L> fitnesses = evaluate(genes);
+    std::vector<L> fitnesses = fitnesses_current ? this->fitnesses : evaluate(genes);
     if(rank != nullptr){
         std::vector<int> ranks = rank(fitnesses);
         for(int i = 0; i < genes.size(); i++){
@@ -159,18 +299,19 @@ std::vector<T> Population<T, L>::get_bests(bool keep_duplicats){
     return bests;
 }
 
-template<typename T, typename L>
-std::vector<T> Population<T, L>::get_genes(){
+template<typename T, typename L, typename G>
+std::vector<T> Population<T, L, G>::get_genes(){
     return genes;
 }
 
-template<typename T, typename L>
-void Population<T, L>::set_genes(std::vector<T> genes){
-    this.genes = genes;
+template<typename T, typename L, typename G>
+void Population<T, L, G>::set_genes(std::vector<T> genes){
+    this->genes = genes;
+    fitnesses_current = false;
 }
 
-template<typename T, typename L>
-std::string Population<T, L>::to_string(){
+template<typename T, typename L, typename G>
+std::string Population<T, L, G>::to_string(){
     std::string s;
     for (auto gene : genes) {
         s += std::to_string(gene) + "\n";
@@ -178,15 +319,21 @@ std::string Population<T, L>::to_string(){
     return s;
 }
 
-template<typename T, typename L>
-void Population<T, L>::set_evaluate(const std::function<std::vector<L>(const std::vector<T>&)>& evaluate){ this.evaluate = evaluate;}
-template<typename T, typename L>
-void Population<T, L>::set_selectParents(const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)>& selectParents){ this.selectParents = selectParents;}
-template<typename T, typename L>
-void Population<T, L>::set_mutate(const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& mutate){ this.mutate = mutate;}
-template<typename T, typename L>
-void Population<T, L>::set_recombine(const std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)>& recombine){ this.recombine = recombine;}
-template<typename T, typename L>
-void Population<T, L>::set_selectSurvivors(const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)>& selectSurvivors){ this.selectSurvivors = selectSurvivors;}
-template<typename T, typename L>
-void Population<T, L>::set_rank(const std::function<std::vector<int>(const std::vector<L>&)>& rank){ this.rank = rank;}
\ No newline at end of file
+template<typename T, typename L, typename G>
+void Population<T, L, G>::set_evaluate(const std::function<std::vector<L>(const std::vector<T>&)>& evaluate){ this->evaluate = evaluate; fitnesses_current = false;}
+template<typename T, typename L, typename G>
+void Population<T, L, G>::set_selectParents(const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)>& selectParents){ this->selectParents = selectParents;}
+template<typename T, typename L, typename G>
+void Population<T, L, G>::set_mutate(const std::function<std::vector<T>(const std::vector<T>&, G&)>& mutate){ this->mutate = mutate;}
+template<typename T, typename L, typename G>
+void Population<T, L, G>::set_recombine(const std::function<std::vector<T>(const std::vector<T>&, G&)>& recombine){ this->recombine = recombine;}
+template<typename T, typename L, typename G>
+void Population<T, L, G>::set_selectSurvivors(const std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)>& selectSurvivors){ this->selectSurvivors = selectSurvivors;}
+template<typename T, typename L, typename G>
+void Population<T, L, G>::set_rank(const std::function<std::vector<int>(const std::vector<L>&)>& rank){ this->rank = rank;}
+template<typename T, typename L, typename G>
+void Population<T, L, G>::set_selectParentIndices(const std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, int, G&)>& selectParentIndices){ this->selectParentIndices = selectParentIndices;}
+template<typename T, typename L, typename G>
+void Population<T, L, G>::set_selectSurvivorIndices(const std::function<std::vector<int>(const std::vector<L>&, const std::vector<int>&, const std::vector<L>&, G&)>& selectSurvivorIndices){ this->selectSurvivorIndices = selectSurvivorIndices;}
+template<typename T, typename L, typename G>
+void Population<T, L, G>::set_selectSurvivorsStreaming(const std::shared_ptr<StreamingSurvivorSelection<L>>& selectSurvivorsStreaming){ this->selectSurvivorsStreaming = selectSurvivorsStreaming;}
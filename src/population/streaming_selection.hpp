@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+// Class Outline ----------------------------------------------------------------------------------------------------------------------------
+
+/*
+    Interface for survivor selections which decide incrementally while the streaming execution creates the offspring batch by batch
+    (see Population::execute_streaming). The next generation consists of slots: begin() fills them with genes of the current generation,
+    and every offspring offered afterwards either takes over a slot or is discarded, so accepted offspring can be moved into the next
+    generation and discarded ones freed before the next batch is created.
+    A selection which can only decide after seeing all offspring (e.g. by Pareto fronts) cannot implement it.
+*/
+template<typename L>
+class StreamingSurvivorSelection{
+
+public:
+
+    virtual ~StreamingSurvivorSelection() = default;
+
+    //starts a generation, returns for every slot of the next generation the distinct index of the current gene it starts with, -1 for an empty slot
+    virtual std::vector<int> begin(const std::vector<L>& fitnesses, const std::vector<int>& ranks) = 0;
+    //offers a batch of offspring, returns for every offspring the slot it takes over, -1 if it is discarded
+    virtual std::vector<int> offer(const std::vector<L>& fitnesses) = 0;
+
+};
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+// Random Engines ---------------------------------------------------------------------------------------------------------------------------
+
+/*
+    All engines satisfy the UniformRandomBitGenerator requirements, so they can be passed as the generator template parameter G of the
+    population and the operators, and can be used with the std distributions and algorithms (e.g. std::shuffle).
+    Engines providing a member generate(uint64_t* out, size_t n) are used directly by the bulk generation functions below.
+*/
+
+// SplitMix64: used to expand a single seed into the state of the other engines
+inline uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/*
+    xoshiro256++: 256 bit state, 64 bit output, very fast general purpose engine
+*/
+
+class Xoshiro256pp {
+
+private:
+
+    uint64_t s[4];
+
+    static inline uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+
+    using result_type = uint64_t;
+
+    explicit Xoshiro256pp(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed) {
+        for (int i = 0; i < 4; i++) {
+            s[i] = splitmix64(seed);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    void generate(uint64_t* out, size_t n) {
+        uint64_t s0 = s[0], s1 = s[1], s2 = s[2], s3 = s[3];
+        for (size_t i = 0; i < n; i++) {
+            out[i] = rotl(s0 + s3, 23) + s0;
+            const uint64_t t = s1 << 17;
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = rotl(s3, 45);
+        }
+        s[0] = s0; s[1] = s1; s[2] = s2; s[3] = s3;
+    }
+};
+
+/*
+    PCG64 (XSL-RR 128/64): 128 bit linear congruential state with a permuted 64 bit output
+*/
+
+class PCG64 {
+
+private:
+
+    __uint128_t state;
+
+    static constexpr __uint128_t multiplier = ((__uint128_t) 0x2360ED051FC65DA4ULL << 64) | 0x4385DF649FCCF645ULL;
+    static constexpr __uint128_t increment  = ((__uint128_t) 0x5851F42D4C957F2DULL << 64) | 0x14057B7EF767814FULL;
+
+    static inline uint64_t rotr(uint64_t x, unsigned k) {
+        return (x >> k) | (x << ((64 - k) & 63));
+    }
+
+public:
+
+    using result_type = uint64_t;
+
+    explicit PCG64(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed) {
+        uint64_t sm = seed;
+        __uint128_t initstate = ((__uint128_t) splitmix64(sm) << 64) | splitmix64(sm);
+        state = 0;
+        (*this)();
+        state += initstate;
+        (*this)();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        state = state * multiplier + increment;
+        return rotr((uint64_t)(state >> 64) ^ (uint64_t) state, (unsigned)(state >> 122));
+    }
+};
+
+/*
+    Philox4x32-10: counter based engine, every block of output is a pure function of (key, counter), so blocks can be generated
+    independently of each other (and the loop in generate() has no dependency between iterations)
+*/
+
+class Philox4x32 {
+
+private:
+
+    uint32_t key[2];
+    uint64_t counter;
+    uint64_t buffer[2];
+    int buffered;
+
+    static inline void mulhilo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo) {
+        uint64_t product = (uint64_t) a * b;
+        hi = (uint32_t)(product >> 32);
+        lo = (uint32_t) product;
+    }
+
+    static inline void block(uint64_t counter, uint32_t k0, uint32_t k1, uint64_t& out0, uint64_t& out1) {
+        uint32_t c0 = (uint32_t) counter, c1 = (uint32_t)(counter >> 32), c2 = 0, c3 = 0;
+        for (int round = 0; round < 10; round++) {
+            uint32_t hi0, lo0, hi1, lo1;
+            mulhilo(0xD2511F53U, c0, hi0, lo0);
+            mulhilo(0xCD9E8D57U, c2, hi1, lo1);
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+            k0 += 0x9E3779B9U;
+            k1 += 0xBB67AE85U;
+        }
+        out0 = ((uint64_t) c1 << 32) | c0;
+        out1 = ((uint64_t) c3 << 32) | c2;
+    }
+
+public:
+
+    using result_type = uint64_t;
+
+    explicit Philox4x32(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed) {
+        key[0] = (uint32_t) seed;
+        key[1] = (uint32_t)(seed >> 32);
+        counter = 0;
+        buffered = 0;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        if (buffered == 0) {
+            block(counter++, key[0], key[1], buffer[0], buffer[1]);
+            buffered = 2;
+        }
+        return buffer[2 - buffered--];
+    }
+
+    void generate(uint64_t* out, size_t n) {
+        size_t i = 0;
+        while (i < n && buffered > 0) {
+            out[i++] = (*this)();
+        }
+        const uint32_t k0 = key[0], k1 = key[1];
+        const size_t blocks = (n - i) / 2;
+        for (size_t b = 0; b < blocks; b++) {
+            block(counter + b, k0, k1, out[i + 2*b], out[i + 2*b + 1]);
+        }
+        counter += blocks;
+        for (i += 2*blocks; i < n; i++) {
+            out[i] = (*this)();
+        }
+    }
+};
+
+// Bulk Generation --------------------------------------------------------------------------------------------------------------------------
+
+/*
+    The bulk functions first draw raw 64 bit words into a fixed size chunk on the stack and then convert the whole chunk in a separate loop
+    without branches, which the compiler can vectorize. They work with every uniform random bit generator: engines with 32 or 64 bit outputs
+    (std::mt19937, std::mt19937_64 and the engines above) are used directly, others (e.g. std::minstd_rand or std::ranlux24) are combined over
+    several calls by std::uniform_int_distribution.
+*/
+
+constexpr size_t random_chunk_size = 256;
+
+// Draws 64 random bits from an engine, with one call for a 64 bit output range, two for a 32 bit one and as many as needed otherwise
+template<typename G>
+inline uint64_t random_bits(G& generator) {
+    constexpr uint64_t range = (uint64_t) G::max() - (uint64_t) G::min();
+    if constexpr (range == std::numeric_limits<uint64_t>::max()) {
+        return (uint64_t)(generator() - G::min());
+    } else if constexpr (range == std::numeric_limits<uint32_t>::max()) {
+        uint64_t high = (uint64_t)(generator() - G::min());
+        return (high << 32) | (uint64_t)(generator() - G::min());
+    } else {
+        return std::uniform_int_distribution<uint64_t>(0, std::numeric_limits<uint64_t>::max())(generator);
+    }
+}
+
+// Fills out[0..n) with raw 64 bit words
+template<typename G>
+void generate_bits(G& generator, uint64_t* out, size_t n) {
+    if constexpr (requires { generator.generate(out, n); }) {
+        generator.generate(out, n);
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = random_bits(generator);
+        }
+    }
+}
+
+// Fills the buffer with doubles uniformly distributed in [min, max)
+template<typename G>
+void generate_uniform_real(G& generator, std::vector<double>& buffer, double min = 0.0, double max = 1.0) {
+    uint64_t bits[random_chunk_size];
+    const double scale = (max - min) * 0x1.0p-53;
+    for (size_t offset = 0; offset < buffer.size(); offset += random_chunk_size) {
+        const size_t n = std::min(random_chunk_size, buffer.size() - offset);
+        generate_bits(generator, bits, n);
+        double* out = buffer.data() + offset;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = min + (double)(bits[i] >> 11) * scale;
+        }
+    }
+}
+
+// Fills the buffer with ints uniformly distributed in [min, max] (multiply-shift reduction, bias below (max - min + 1) / 2^32)
+template<typename G>
+void generate_uniform_int(G& generator, std::vector<int>& buffer, int min, int max) {
+    uint64_t bits[random_chunk_size];
+    const uint64_t range = (uint64_t)((int64_t) max - (int64_t) min + 1);
+    for (size_t offset = 0; offset < buffer.size(); offset += random_chunk_size) {
+        const size_t n = std::min(random_chunk_size, buffer.size() - offset);
+        generate_bits(generator, bits, n);
+        int* out = buffer.data() + offset;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = (int)((int64_t) min + (int64_t)(((bits[i] >> 32) * range) >> 32));
+        }
+    }
+}
+
+// Layers of the ziggurat for the standard normal distribution (128 layers of equal area, Marsaglia and Tsang, with the tables of Doornik)
+struct NormalZiggurat{
+    static constexpr double tail = 3.442619855899;          // start of the tail of the base layer
+    static constexpr double area = 9.91256303526217e-3;     // area of every layer
+    double x[129];      // right edges of the layers
+    double ratio[128];  // x[i + 1] / x[i], a sample below it lies inside the ziggurat without evaluating the density
+
+    NormalZiggurat() {
+        double f = std::exp(-0.5 * tail * tail);
+        x[0] = area / f;
+        x[1] = tail;
+        x[128] = 0;
+        for (int i = 2; i < 128; i++) {
+            x[i] = std::sqrt(-2.0 * std::log(area / x[i - 1] + f));
+            f = std::exp(-0.5 * x[i] * x[i]);
+        }
+        for (int i = 0; i < 128; i++) {
+            ratio[i] = x[i + 1] / x[i];
+        }
+    }
+
+    static const NormalZiggurat& get() {
+        static const NormalZiggurat ziggurat;
+        return ziggurat;
+    }
+};
+
+// Fills the buffer with normally distributed doubles, using one 64 bit word per variate except for the rare rejections (ziggurat method)
+template<typename G>
+void generate_normal(G& generator, std::vector<double>& buffer, double mean = 0.0, double stddev = 1.0) {
+    const NormalZiggurat& ziggurat = NormalZiggurat::get();
+    auto uniform = [&generator]() -> double {
+        return (double)(random_bits(generator) >> 11) * 0x1.0p-53;
+    };
+    // the word of a variate is split into the layer (lowest 7 bits) and a uniform value in [-1, 1) (highest 53 bits)
+    auto rejected = [&](uint64_t word) -> double {
+        while (true) {
+            const int layer = word & 0x7F;
+            const double u = 2.0 * (double)(word >> 11) * 0x1.0p-53 - 1.0;
+            if (std::abs(u) < ziggurat.ratio[layer]) {
+                return u * ziggurat.x[layer];
+            }
+            if (layer == 0) {
+                double x, y;
+                do {
+                    x = std::log(1.0 - uniform()) / NormalZiggurat::tail;
+                    y = std::log(1.0 - uniform());
+                } while (-2.0 * y < x * x);
+                return u < 0 ? x - NormalZiggurat::tail : NormalZiggurat::tail - x;
+            }
+            const double x = u * ziggurat.x[layer];
+            const double f0 = std::exp(-0.5 * (ziggurat.x[layer] * ziggurat.x[layer] - x * x));
+            const double f1 = std::exp(-0.5 * (ziggurat.x[layer + 1] * ziggurat.x[layer + 1] - x * x));
+            if (f1 + uniform() * (f0 - f1) < 1.0) {
+                return x;
+            }
+            word = random_bits(generator);
+        }
+    };
+    uint64_t bits[random_chunk_size];
+    for (size_t offset = 0; offset < buffer.size(); offset += random_chunk_size) {
+        const size_t n = std::min(random_chunk_size, buffer.size() - offset);
+        generate_bits(generator, bits, n);
+        double* out = buffer.data() + offset;
+        for (size_t i = 0; i < n; i++) {
+            const int layer = bits[i] & 0x7F;
+            const double u = 2.0 * (double)(bits[i] >> 11) * 0x1.0p-53 - 1.0;
+            const double normal = std::abs(u) < ziggurat.ratio[layer] ? u * ziggurat.x[layer] : rejected(bits[i]);
+            out[i] = mean + stddev * normal;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../experiment/experiment.hpp"
+#include "../population/population.hpp"
+#include "../operator/operators_parentSelection.hpp"
+#include "../operator/operators_mutation.hpp"
+#include "../operator/operators_recombination.hpp"
+#include "../operator/operators_survivorSelection.hpp"
+#include "../operator/operators_evaluation.hpp"
+#include "../operator/operators_initialization.hpp"
+
+#include <iostream>
+
+// Sweeps tournament size and mutation rate of the sum problem over several seeds with racing
+void test_experiment(){
+
+    using T = std::vector<int>;
+    using L = double;
+    using C = std::tuple<int, double>;
+
+    std::vector<C> configurations = configuration_grid<int, double>({2, 4}, {0.0, 0.1, 0.5});
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_so = evaluate_sum();
+    std::function<Population<T, L>(const C&, int, const std::function<std::vector<L>(const std::vector<T>&)>&)> build = [](const C& configuration, int seed, const std::function<std::vector<L>(const std::vector<T>&)>& evaluate) -> Population<T, L> {
+        std::function<std::vector<T>(std::mt19937&)> initialize_so = initialize_random(50, 30, {0,1,2,3,4,5,6,7,8,9});
+        std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_parents_so = select_tournament<T, L>(std::get<0>(configuration));
+        std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> mutate_so = mutate_numeric(std::get<1>(configuration), 0.5, 9, 0);
+        std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> recombine_so = recombine_midpoint();
+        std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)> select_so = select_mu<T, L>(50, evaluate);
+        return Population<T, L>(seed, initialize_so, evaluate, select_parents_so, mutate_so, recombine_so, select_so, nullptr);
+    };
+
+    Experiment<T, C> experiment(configurations, {0, 1, 2, 3, 4, 5}, evaluate_so, build, 60, 240);
+    experiment.set_racing(10, 3, 2.0);
+    ThreadPool pool(2);
+    experiment.run(pool, [&configurations](const RunSummary& summary){
+        if(summary.skipped){
+            std::cout << "tournament " << std::get<0>(configurations[summary.configuration]) << ", mutation rate " << std::to_string(std::get<1>(configurations[summary.configuration]));
+            std::cout << ", seed " << summary.seed << " skipped\n";
+            return;
+        }
+        std::cout << "tournament " << std::get<0>(configurations[summary.configuration]) << ", mutation rate " << std::to_string(std::get<1>(configurations[summary.configuration]));
+        std::cout << ", seed " << summary.seed << " -> best " << std::to_string(summary.best_fitness) << ", time to target " << std::to_string(summary.time_to_target);
+        std::cout << ", evaluations " << summary.evaluations << ", generations " << summary.generations << (summary.eliminated ? " (eliminated)" : "") << "\n";
+    });
+}
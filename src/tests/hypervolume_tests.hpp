@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../indicator/hypervolume.hpp"
+#include "../population/population.hpp"
+#include "../operator/operators_parentSelection.hpp"
+#include "../operator/operators_mutation.hpp"
+#include "../operator/operators_recombination.hpp"
+#include "../operator/operators_survivorSelection.hpp"
+#include "../operator/operators_evaluation.hpp"
+#include "../operator/operators_initialization.hpp"
+#include "../operator/operators_ranking.hpp"
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+
+// Solves the below3 sum problem with hypervolume survivor selection until the hypervolume stagnates and compares the time of the indicator to the time of the generations
+void test_hypervolume(){
+
+    using T = std::vector<int>;
+    using L = std::vector<double>;
+
+    std::vector<double> reference = {-1, -1};
+    std::function<std::vector<T>(std::mt19937&)> initialize_mo = initialize_random(100, 30, {0,1,2,3,4,5,6,7,8,9});
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_mo = evaluate_bel3sum();
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_parents_mo = select_tournament_rank<T, L>(4);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> mutate_mo = mutate_numeric(0.1, 0.5, 9, 0);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> recombine_mo = recombine_midpoint();
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)> select_mo = select_hypervolume<T>(100, evaluate_mo, reference);
+    std::function<std::vector<int>(const std::vector<L>&)> rank_mo = rank_pareto<L>();
+
+    Population<T, L> population_mo(0, initialize_mo, evaluate_mo, select_parents_mo, mutate_mo, recombine_mo, select_mo, rank_mo);
+    HypervolumeStagnation stagnation(reference, 20);
+    double generation_time = 0;
+    double indicator_time = 0;
+    int generations = 0;
+    while(generations < 300){
+        auto start = std::chrono::steady_clock::now();
+        population_mo.execute();
+        auto executed = std::chrono::steady_clock::now();
+        bool stagnates = stagnation.update(evaluate_mo(population_mo.get_genes()));
+        generation_time += std::chrono::duration<double>(executed - start).count();
+        indicator_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - executed).count();
+        generations++;
+        if(stagnates){
+            break;
+        }
+    }
+    std::cout << "hypervolume " << stagnation.get_hypervolume() << " after " << generations << " generations, generations " << generation_time << "s, indicator " << indicator_time << "s\n";
+
+    // the hypervolume of an archive filled point by point equals the one of all points
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(0, 1);
+    std::vector<std::vector<double>> points(200, std::vector<double>(3));
+    HypervolumeArchive archive({0, 0, 0});
+    for(std::vector<double>& point : points){
+        for(double& value : point){
+            value = distribution(generator);
+        }
+        archive.insert(point);
+    }
+    std::cout << "hypervolume 3d " << hypervolume(points, {0, 0, 0}) << ", archive " << archive.get_hypervolume() << " with " << archive.get_points().size() << " points\n";
+
+    // reducing a nondominated front of 200 points on the unit sphere to 100 with three objectives
+    std::vector<std::vector<double>> parents(100, std::vector<double>(3));
+    std::vector<std::vector<double>> offspring(100, std::vector<double>(3));
+    for(std::vector<std::vector<double>>* fitnesses : {&parents, &offspring}){
+        for(std::vector<double>& point : *fitnesses){
+            double norm = 0;
+            for(double& value : point){
+                value = distribution(generator);
+                norm += value * value;
+            }
+            for(double& value : point){
+                value /= std::sqrt(norm);
+            }
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<int> survivors = select_hypervolume_indices(100, {0, 0, 0})(parents, {}, offspring, generator);
+    double selection_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::vector<std::vector<double>> survivor_fitnesses;
+    for(int survivor : survivors){
+        survivor_fitnesses.emplace_back(survivor < parents.size() ? parents[survivor] : offspring[survivor - parents.size()]);
+    }
+    std::cout << "hypervolume selection 3d: " << survivors.size() << " of 200 points, hypervolume " << hypervolume(survivor_fitnesses, {0, 0, 0}) << " in " << selection_time << "s\n";
+}
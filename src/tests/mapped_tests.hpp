@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../population/population.hpp"
+#include "../population/mapped_population.hpp"
+#include "../operator/operators_parentSelection.hpp"
+#include "../operator/operators_mutation.hpp"
+#include "../operator/operators_recombination.hpp"
+#include "../operator/operators_survivorSelection.hpp"
+#include "../operator/operators_evaluation.hpp"
+#include "../operator/operators_initialization.hpp"
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+// Compares the throughput of in-memory populations of one block each with the memory-mapped population on a population that fits into the
+// page cache, so both select parents and survivors within blocks of the same size and only the storage differs
+void test_mapped(){
+
+    using T = std::vector<int>;
+    using L = double;
+
+    const int population_size = 20000;
+    const int gene_length = 100;
+    const int block_size = 2000;
+    const int generations = 10;
+
+    long evaluations = 0;
+    std::function<std::vector<T>(std::mt19937&)> initialize_block = initialize_random(block_size, gene_length, {0,1,2,3,4,5,6,7,8,9});
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_so = [&evaluations](const std::vector<T>& genes) -> std::vector<L> {
+        evaluations += genes.size();
+        return evaluate_sum()(genes);
+    };
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_parents_so = select_tournament<T, L>(4);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> mutate_so = mutate_numeric(0.1, 0.5, 9, 0);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> recombine_so = recombine_midpoint();
+
+    std::vector<Population<T, L>> blocks_memory;
+    for(int block = 0; block < population_size / block_size; block++){
+        blocks_memory.emplace_back(block, initialize_block, evaluate_so, select_parents_so, mutate_so, recombine_so, nullptr, nullptr);
+        blocks_memory.back().set_selectSurvivorIndices(select_mu_indices<L>(block_size));
+    }
+    for(Population<T, L>& block : blocks_memory){
+        block.execute();
+    }
+    evaluations = 0;
+    auto start_memory = std::chrono::steady_clock::now();
+    for(int generation = 0; generation < generations; generation++){
+        for(Population<T, L>& block : blocks_memory){
+            block.execute();
+        }
+    }
+    std::chrono::duration<double> time_memory = std::chrono::steady_clock::now() - start_memory;
+    long evaluations_memory = evaluations;
+    double best_memory = 0;
+    for(Population<T, L>& block : blocks_memory){
+        best_memory = std::max(best_memory, evaluate_sum()(block.get_bests(false))[0]);
+    }
+
+    std::string path = (std::filesystem::temp_directory_path() / "eaframework_mapped_population").string();
+    MappedPopulation<int, L> population_mapped(0, path, population_size, gene_length, block_size, initialize_block, evaluate_so, select_parents_so, mutate_so, recombine_so, nullptr, nullptr);
+    population_mapped.set_selectSurvivorIndices(select_mu_indices<L>(block_size));
+    population_mapped.execute();
+    evaluations = 0;
+    auto start_mapped = std::chrono::steady_clock::now();
+    population_mapped.execute_multiple(generations);
+    std::chrono::duration<double> time_mapped = std::chrono::steady_clock::now() - start_mapped;
+    long evaluations_mapped = evaluations;
+    double best_mapped = evaluate_sum()(population_mapped.get_bests(false))[0];
+
+    std::cout << "in-memory blocks: " << std::to_string(generations / time_memory.count()) << " generations/s, " << evaluations_memory / generations << " evaluations per generation, best " << std::to_string(best_memory) << "\n";
+    std::cout << "mapped:           " << std::to_string(generations / time_mapped.count()) << " generations/s, " << evaluations_mapped / generations << " evaluations per generation, best " << std::to_string(best_mapped) << "\n";
+}
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "../population/population.hpp"
 #include "../operator/operators_parentSelection.hpp"
 #include "../operator/operators_mutation.hpp"
@@ -64,6 +66,32 @@ void test_sum(){
     }
 }
 
+void test_sum_streaming(){
+
+    using T = std::vector<int>;
+    using L = double;
+
+    std::function<std::vector<T>(std::mt19937&)> initialize_so = initialize_random(100, 30, {0,1,2,3,4,5,6,7,8,9});
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_so = evaluate_sum();
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_parents_so = select_tournament<T, L>(4);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> mutate_so = mutate_numeric(0.1, 0.5, 9, 0);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> recombine_so = recombine_midpoint();
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)> select_so = select_mu<T, L>(100, evaluate_so);
+
+    Population<T, L> population_so(0, initialize_so, evaluate_so, select_parents_so, mutate_so, recombine_so, select_so, nullptr);
+    population_so.set_selectParentIndices(select_tournament_indices<L>(4));
+    population_so.set_selectSurvivorsStreaming(select_mu_streaming<L>(100));
+    population_so.execute_multiple_streaming(100, 16);
+    std::vector<T> best_so = population_so.get_bests(false);
+    const std::vector<L> best_so_eval = evaluate_so(best_so);
+    for (int i = 0; i < best_so.size(); i++) {
+        for (auto chromosome : best_so[i]) {
+            std::cout << std::to_string(chromosome) + " ";
+        }
+        std::cout << " -> " << std::to_string(best_so_eval[i]) << "\n";
+    }
+}
+
 void test_bel3um(){
 
     using T = std::vector<int>;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../indicator/hypervolume.hpp"
+#include "../population/population.hpp"
+#include "../operator/operators_parentSelection.hpp"
+#include "../operator/operators_mutation.hpp"
+#include "../operator/operators_recombination.hpp"
+#include "../operator/operators_survivorSelection.hpp"
+#include "../operator/operators_evaluation.hpp"
+#include "../operator/operators_initialization.hpp"
+#include "../operator/operators_ranking.hpp"
+
+#include <iostream>
+#include <chrono>
+
+// Solves the below3 sum problem with NSGA-II survivor selection for a small and a large population and prints the hypervolume of the fronts
+void test_nsga2(){
+
+    using T = std::vector<int>;
+    using L = std::vector<double>;
+
+    std::vector<double> reference = {-1, -1};
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_mo = evaluate_bel3sum();
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_parents_mo = select_tournament_rank<T, L>(4);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> mutate_mo = mutate_numeric(0.1, 0.5, 9, 0);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> recombine_mo = recombine_midpoint();
+    std::function<std::vector<int>(const std::vector<L>&)> rank_mo = rank_pareto<L>();
+
+    for(int size : {100, 50000}){
+        int generations = size < 1000 ? 100 : 5;
+        std::function<std::vector<T>(std::mt19937&)> initialize_mo = initialize_random(size, 30, {0,1,2,3,4,5,6,7,8,9});
+        std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, std::mt19937&)> select_mo = select_nsga2<T, L>(size, evaluate_mo);
+        Population<T, L> population_mo(0, initialize_mo, evaluate_mo, select_parents_mo, mutate_mo, recombine_mo, select_mo, rank_mo);
+        auto start = std::chrono::steady_clock::now();
+        population_mo.execute_multiple(generations);
+        double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::vector<L> bests_mo_eval = evaluate_mo(population_mo.get_bests(false));
+        std::cout << "nsga2 population " << size << ": " << bests_mo_eval.size() << " nondominated genes, hypervolume " << hypervolume(bests_mo_eval, reference);
+        std::cout << " after " << generations << " generations in " << time << "s\n";
+    }
+
+    // the index based selection reuses the fitness values of the survivors, so only the offspring are evaluated and the result is the same
+    long evaluations = 0;
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_counted = [&evaluations, &evaluate_mo](const std::vector<T>& genes) -> std::vector<L> {
+        evaluations += genes.size();
+        return evaluate_mo(genes);
+    };
+    std::function<std::vector<T>(std::mt19937&)> initialize_mo = initialize_random(100, 30, {0,1,2,3,4,5,6,7,8,9});
+    Population<T, L> population_genes(0, initialize_mo, evaluate_counted, select_parents_mo, mutate_mo, recombine_mo, select_nsga2<T, L>(100, evaluate_counted), rank_mo);
+    population_genes.execute_multiple(100);
+    long evaluations_genes = evaluations;
+    evaluations = 0;
+    Population<T, L> population_indices(0, initialize_mo, evaluate_counted, select_parents_mo, mutate_mo, recombine_mo, nullptr, rank_mo);
+    population_indices.set_selectSurvivorIndices(select_nsga2_indices<L>(100));
+    population_indices.execute_multiple(100);
+    std::cout << "nsga2 evaluations per generation: genes " << evaluations_genes / 100.0 << ", indices " << evaluations / 100.0;
+    std::cout << ", same genes " << (population_genes.get_genes() == population_indices.get_genes() ? "yes" : "no") << "\n";
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../population/population.hpp"
+#include "../operator/operators_portfolio.hpp"
+#include "../operator/operators_parentSelection.hpp"
+#include "../operator/operators_mutation.hpp"
+#include "../operator/operators_recombination.hpp"
+#include "../operator/operators_survivorSelection.hpp"
+#include "../operator/operators_evaluation.hpp"
+#include "../operator/operators_initialization.hpp"
+
+#include <iostream>
+
+// Solves the sum problem with adaptive portfolios of mutation and recombination operators and prints their statistics
+void test_portfolio(){
+
+    using T = std::vector<int>;
+    using L = double;
+
+    std::function<std::vector<T>(std::mt19937&)> initialize_so = initialize_random(100, 30, {0,1,2,3,4,5,6,7,8,9});
+    long evaluations = 0;
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_so = [&evaluations](const std::vector<T>& genes) -> std::vector<L> {
+        evaluations += genes.size();
+        return evaluate_sum()(genes);
+    };
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_parents_so = select_tournament<T, L>(4);
+
+    std::shared_ptr<OperatorPortfolio<T>> mutations = std::make_shared<OperatorPortfolio<T>>();
+    mutations->add("numeric", mutate_numeric(0.5, 0.5, 9, 0));
+    mutations->add("swap", mutate_swap(0.5));
+    std::shared_ptr<OperatorPortfolio<T>> recombinations = std::make_shared<OperatorPortfolio<T>>();
+    recombinations->add("midpoint", recombine_midpoint());
+    recombinations->add("none", [](const std::vector<T>& parents, std::mt19937& generator) -> std::vector<T> { return parents; });
+
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> mutate_so = apply_portfolio(mutations);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> recombine_so = apply_portfolio(recombinations);
+
+    // the portfolios are credited with the fitness values of the offspring evaluated for the survivor selection, so they evaluate nothing
+    Population<T, L> population_so(0, initialize_so, evaluate_so, select_parents_so, mutate_so, recombine_so, nullptr, nullptr);
+    population_so.set_selectSurvivorIndices(select_crediting<T>({mutations, recombinations}, select_mu_indices<L>(100)));
+    population_so.execute();
+    evaluations = 0;
+    population_so.execute_multiple(100);
+    std::vector<T> best_so = population_so.get_bests(false);
+    std::cout << "best " << std::to_string(evaluate_sum()(best_so)[0]) << ", " << evaluations / 100.0 / 100 << " population evaluations per generation\n";
+    std::cout << mutations->to_string() << recombinations->to_string();
+
+    // the streaming execution credits the portfolios batch by batch
+    Population<T, L> population_streaming(0, initialize_so, evaluate_so, select_parents_so, mutate_so, recombine_so, nullptr, nullptr);
+    population_streaming.set_selectParentIndices(select_tournament_indices<L>(4));
+    population_streaming.set_selectSurvivorsStreaming(select_crediting_streaming<T>({mutations, recombinations}, select_mu_streaming<L>(100)));
+    population_streaming.execute_streaming(16);
+    evaluations = 0;
+    population_streaming.execute_multiple_streaming(100, 16);
+    best_so = population_streaming.get_bests(false);
+    std::cout << "streaming best " << std::to_string(evaluate_sum()(best_so)[0]) << ", " << evaluations / 100.0 / 100 << " population evaluations per generation\n";
+    std::cout << mutations->to_string() << recombinations->to_string();
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "../population/population.hpp"
+#include "../evaluation/process_evaluator.hpp"
+#include "../experiment/thread_pool.hpp"
+#include "../operator/operators_parentSelection.hpp"
+#include "../operator/operators_mutation.hpp"
+#include "../operator/operators_recombination.hpp"
+#include "../operator/operators_survivorSelection.hpp"
+#include "../operator/operators_evaluation.hpp"
+#include "../operator/operators_initialization.hpp"
+
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+// Runs the sum problem with an evaluation that crashes or throws in its worker process on every 25th call, compares the fitness values to
+// in-process evaluation and compares the throughput of worker processes and in-process threads for an evaluation taking 1 ms per gene
+void test_process(){
+
+    using T = std::vector<int>;
+    using L = double;
+
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_so = evaluate_sum();
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_crashing = [evaluate_so](const std::vector<T>& genes) -> std::vector<L> {
+        static int calls = 0;
+        if(++calls % 50 == 0){
+            std::abort();
+        }
+        if(calls % 50 == 25){
+            throw std::bad_alloc();
+        }
+        if(calls % 50 == 40){
+            return std::vector<L>(genes.size() - 1);
+        }
+        return evaluate_so(genes);
+    };
+
+    std::function<std::vector<T>(std::mt19937&)> initialize_so = initialize_random(100, 30, {0,1,2,3,4,5,6,7,8,9});
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_workers = evaluate_processes<int, L>(evaluate_crashing, 30, 2, 10, 0.0);
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_parents_so = select_tournament<T, L>(4);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> mutate_so = mutate_numeric(0.1, 0.5, 9, 0);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> recombine_so = recombine_midpoint();
+
+    Population<T, L> population_so(0, initialize_so, evaluate_workers, select_parents_so, mutate_so, recombine_so, nullptr, nullptr);
+    population_so.execute_multiple(20);
+    std::vector<T> genes = population_so.get_genes();
+    bool equal = evaluate_workers(genes) == evaluate_so(genes);
+    std::cout << "process evaluation matches in-process evaluation: " << (equal ? "yes" : "no") << "\n";
+
+    // the same evaluator called by 4 threads at once
+    std::vector<std::vector<L>> fitnesses_threads(4);
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; i++){
+        threads.emplace_back([&evaluate_workers, &fitnesses_threads, &genes, i]{
+            fitnesses_threads[i] = evaluate_workers(genes);
+        });
+    }
+    bool equal_threads = true;
+    for(int i = 0; i < 4; i++){
+        threads[i].join();
+        equal_threads = equal_threads && fitnesses_threads[i] == evaluate_so(genes);
+    }
+    std::cout << "process evaluation called by 4 threads matches: " << (equal_threads ? "yes" : "no") << "\n";
+
+    // evaluation hanging on every 20th call in a worker, killed after 50 ms, and evaluation replacing its worker after every 5 batches
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_hanging = [evaluate_so](const std::vector<T>& genes) -> std::vector<L> {
+        static int calls = 0;
+        if(++calls % 20 == 0){
+            sleep(60);
+        }
+        return evaluate_so(genes);
+    };
+    ProcessEvaluator<int, L> evaluator_hanging(evaluate_hanging, 30, 2, 10, 0.0, 3, 0.05);
+    ProcessEvaluator<int, L> evaluator_recycled(evaluate_so, 30, 2, 10, 0.0, 3, 0, 5);
+    bool equal_hanging = true;
+    bool equal_recycled = true;
+    for(int i = 0; i < 5; i++){
+        equal_hanging = equal_hanging && evaluator_hanging(genes) == evaluate_so(genes);
+        equal_recycled = equal_recycled && evaluator_recycled(genes) == evaluate_so(genes);
+    }
+    std::cout << "process evaluation with timeout matches: " << (equal_hanging ? "yes" : "no") << " (" << evaluator_hanging.get_restarts() << " workers killed)";
+    std::cout << ", with recycled workers matches: " << (equal_recycled ? "yes" : "no") << " (" << evaluator_recycled.get_restarts() << " crashes)\n";
+
+    // evaluation spinning for 1 ms per gene, evaluated by 4 worker processes and by 4 threads of a pool in batches of 10 genes
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_slow = [evaluate_so](const std::vector<T>& genes) -> std::vector<L> {
+        for(int i = 0; i < genes.size(); i++){
+            auto start = std::chrono::steady_clock::now();
+            while(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1)){}
+        }
+        return evaluate_so(genes);
+    };
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_slow_workers = evaluate_processes<int, L>(evaluate_slow, 30, 4, 10, 0.0);
+    ThreadPool pool(4);
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_slow_threads = [&pool, evaluate_slow](const std::vector<T>& genes) -> std::vector<L> {
+        std::vector<L> fitnesses(genes.size());
+        for(int begin = 0; begin < genes.size(); begin += 10){
+            pool.submit([&genes, &fitnesses, &evaluate_slow, begin]{
+                int end = std::min((int) genes.size(), begin + 10);
+                std::vector<L> batch = evaluate_slow(std::vector<T>(genes.begin() + begin, genes.begin() + end));
+                std::copy(batch.begin(), batch.end(), fitnesses.begin() + begin);
+            });
+        }
+        pool.wait();
+        return fitnesses;
+    };
+    std::mt19937 generator(0);
+    std::vector<T> initial_genes = initialize_so(generator);
+    auto start = std::chrono::steady_clock::now();
+    bool equal_slow = evaluate_slow_workers(initial_genes) == evaluate_so(initial_genes);
+    double processes_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    equal_slow = equal_slow && evaluate_slow_threads(initial_genes) == evaluate_so(initial_genes);
+    double threads_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "100 genes at 1 ms: 4 worker processes " << processes_time << "s, 4 threads " << threads_time << "s" << (equal_slow ? "" : " (fitness values differ)") << "\n";
+}
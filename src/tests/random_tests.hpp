@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../random/random.hpp"
+#include "../population/population.hpp"
+#include "../operator/operators_parentSelection.hpp"
+#include "../operator/operators_mutation.hpp"
+#include "../operator/operators_recombination.hpp"
+#include "../operator/operators_survivorSelection.hpp"
+#include "../operator/operators_evaluation.hpp"
+#include "../operator/operators_initialization.hpp"
+
+#include <iostream>
+
+// Solves the sum problem with a population and operators using the random engine G and returns the best fitness
+template<typename G>
+double run_sum_with_engine(){
+
+    using T = std::vector<int>;
+    using L = double;
+
+    std::function<std::vector<T>(G&)> initialize_so = initialize_random<G>(100, 30, {0,1,2,3,4,5,6,7,8,9});
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_so = evaluate_sum();
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, G&)> select_parents_so = select_tournament<T, L, G>(4);
+    std::function<std::vector<T>(const std::vector<T>&, G&)> mutate_so = mutate_numeric<G>(0.1, 0.5, 9, 0);
+    std::function<std::vector<T>(const std::vector<T>&, G&)> recombine_so = recombine_midpoint<G>();
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, const std::vector<T>&, G&)> select_so = select_mu<T, L, G>(100, evaluate_so);
+
+    Population<T, L, G> population_so(0, initialize_so, evaluate_so, select_parents_so, mutate_so, recombine_so, select_so, nullptr);
+    population_so.execute_multiple(100);
+    return evaluate_so(population_so.get_bests(false))[0];
+}
+
+// Runs the sum problem with the new and some standard engines, checks Philox4x32 against the Random123 known-answer vector and prints the buckets of the bulk generators
+void test_random(){
+
+    std::cout << "engines: mt19937 " << run_sum_with_engine<std::mt19937>() << ", xoshiro256++ " << run_sum_with_engine<Xoshiro256pp>();
+    std::cout << ", pcg64 " << run_sum_with_engine<PCG64>() << ", philox4x32 " << run_sum_with_engine<Philox4x32>();
+    // engines with neither 32 nor 64 bits per call
+    std::cout << ", default_random_engine " << run_sum_with_engine<std::default_random_engine>() << ", ranlux24 " << run_sum_with_engine<std::ranlux24>() << "\n";
+
+    // philox4x32-10 with key 0 and counter 0 returns the words 6627e8d5 e169c58d bc57ac4c 9b00dbd8, generate() has to match operator()
+    Philox4x32 philox(0);
+    Philox4x32 philox_bulk(0);
+    uint64_t words[3];
+    philox_bulk.generate(words, 3);
+    bool known_answer = philox() == 0xe169c58d6627e8d5ULL && philox() == 0x9b00dbd8bc57ac4cULL;
+    bool bulk_matches = words[0] == 0xe169c58d6627e8d5ULL && words[1] == 0x9b00dbd8bc57ac4cULL && words[2] == philox();
+    std::cout << "philox4x32 known answer " << (known_answer ? "ok" : "mismatch") << ", bulk generation " << (bulk_matches ? "ok" : "mismatch") << "\n";
+
+    // buckets of 10^6 ints in [0, 9] and doubles in [0, 1) split into 10 intervals, every bucket should hold about 100000 values
+    Xoshiro256pp generator(0);
+    std::vector<int> ints(1000000);
+    std::vector<double> reals(1000000);
+    generate_uniform_int(generator, ints, 0, 9);
+    generate_uniform_real(generator, reals);
+    std::vector<int> int_buckets(10, 0);
+    std::vector<int> real_buckets(10, 0);
+    for(int value : ints){
+        int_buckets[value]++;
+    }
+    for(double value : reals){
+        real_buckets[(int) (value * 10)]++;
+    }
+    std::cout << "generate_uniform_int buckets:";
+    for(int count : int_buckets){
+        std::cout << " " << count;
+    }
+    std::cout << "\ngenerate_uniform_real buckets:";
+    for(int count : real_buckets){
+        std::cout << " " << count;
+    }
+    std::cout << "\n";
+}
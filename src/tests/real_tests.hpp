@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../population/population.hpp"
+#include "../random/random.hpp"
+#include "../operator/operators_parentSelection.hpp"
+#include "../operator/operators_mutation.hpp"
+#include "../operator/operators_recombination.hpp"
+#include "../operator/operators_survivorSelection.hpp"
+#include "../operator/operators_evaluation.hpp"
+#include "../operator/operators_initialization.hpp"
+
+#include <iostream>
+#include <chrono>
+
+// Minimizes sphere, Rastrigin and Rosenbrock functions with the real-valued operators and compares bulk normal generation to std::normal_distribution
+void test_real(){
+
+    using T = std::vector<double>;
+    using L = double;
+
+    std::function<std::vector<T>(std::mt19937&)> initialize_real = initialize_uniform_real<double>(100, 30, -5.12, 5.12);
+    std::function<std::vector<T>(const std::vector<T>&, const std::vector<L>&, const std::vector<int>&, std::mt19937&)> select_parents_real = select_tournament<T, L>(4);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> mutate_gaussian_real = mutate_gaussian<double>(1.0 / 30, 0.5, -5.12, 5.12);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> mutate_polynomial_real = mutate_polynomial<double>(1.0 / 30, 20, -5.12, 5.12, BoundsHandling::reflect);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> recombine_sbx_real = recombine_sbx<double>(2, -5.12, 5.12);
+    std::function<std::vector<T>(const std::vector<T>&, std::mt19937&)> recombine_blend_real = recombine_blend<double>(0.5, -5.12, 5.12, BoundsHandling::reflect);
+
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_sphere_real = evaluate_sphere<double>();
+    Population<T, L> population_sphere(0, initialize_real, evaluate_sphere_real, select_parents_real, mutate_gaussian_real, recombine_sbx_real, select_mu<T, L>(100, evaluate_sphere_real), nullptr);
+    population_sphere.execute_multiple(200);
+    std::cout << "sphere " << evaluate_sphere_real(population_sphere.get_bests(false))[0] << "\n";
+
+    std::function<std::vector<L>(const std::vector<T>&)> evaluate_rastrigin_real = evaluate_rastrigin<double>();
+    Population<T, L> population_rastrigin(0, initialize_real, evaluate_rastrigin_real, select_parents_real, mutate_polynomial_real, recombine_blend_real, select_mu<T, L>(100, evaluate_rastrigin_real), nullptr);
+    population_rastrigin.execute_multiple(200);
+    std::cout << "rastrigin " << evaluate_rastrigin_real(population_rastrigin.get_bests(false))[0] << "\n";
+
+    // single precision genes
+    using F = std::vector<float>;
+    std::function<std::vector<L>(const std::vector<F>&)> evaluate_rosenbrock_real = evaluate_rosenbrock<float>();
+    Population<F, L> population_rosenbrock(0, initialize_uniform_real<float>(100, 10, -2, 2), evaluate_rosenbrock_real, select_tournament<F, L>(4),
+        mutate_gaussian<float>(0.1, 0.05, -2, 2), recombine_sbx<float>(15, -2, 2), select_mu<F, L>(100, evaluate_rosenbrock_real), nullptr);
+    population_rosenbrock.execute_multiple(200);
+    std::cout << "rosenbrock " << evaluate_rosenbrock_real(population_rosenbrock.get_bests(false))[0] << "\n";
+
+    std::mt19937 generator(0);
+    std::vector<double> normals(1 << 20);
+    auto start = std::chrono::steady_clock::now();
+    generate_normal(generator, normals);
+    double bulk_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double mean = 0;
+    for(double value : normals){
+        mean += value / normals.size();
+    }
+    std::normal_distribution<double> distribution(0, 1);
+    start = std::chrono::steady_clock::now();
+    for(double& value : normals){
+        value = distribution(generator);
+    }
+    double distribution_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "normals: bulk " << bulk_time << "s (mean " << mean << "), std::normal_distribution " << distribution_time << "s\n";
+}